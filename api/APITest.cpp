@@ -0,0 +1,131 @@
+/*
+ This file is part of OpenMalaria.
+
+ Copyright (C) 2005-2015 Swiss Tropical and Public Health Institute
+ Copyright (C) 2005-2015 Liverpool School Of Tropical Medicine
+
+ OpenMalaria is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or (at
+ your option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* Test of the C API: a simulation is run to its first survey and
+ * snapshotted; restoring the snapshot into a new simulation (after freeing
+ * the first) must give the same results, as must loading and running the
+ * scenario again.
+ * 
+ * Usage: openMalariaAPITest SCENARIO RESOURCE_PATH */
+
+#include "OpenMalariaAPI.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    struct Results {
+        vector<uint32_t> survey, ageGroup, cohortSet, species, genotype, drug;
+        vector<int32_t> measure;
+        vector<double> value;
+        
+        bool operator==( const Results& that ) const{
+            return survey == that.survey && ageGroup == that.ageGroup &&
+                cohortSet == that.cohortSet && species == that.species &&
+                genotype == that.genotype && drug == that.drug &&
+                measure == that.measure && value == that.value;
+        }
+    };
+    
+    void fail( const string& msg ){
+        fprintf( stderr, "API test failed: %s\n", msg.c_str() );
+        exit( EXIT_FAILURE );
+    }
+    void check( int code, const char* function ){
+        if( code != 0 )
+            fail( string( function ).append( ": " ).append( om_last_error() ) );
+    }
+    
+    om_simulation* load( const string& xml, const char* resourcePath ){
+        om_simulation* sim = om_load( xml.data(), xml.size(), resourcePath );
+        if( sim == 0 ) fail( string( "om_load: " ).append( om_last_error() ) );
+        return sim;
+    }
+    
+    Results collect( om_simulation* sim ){
+        size_t rows;
+        check( om_collect_results( sim, &rows ), "om_collect_results" );
+        Results r;
+        r.survey.resize( rows ); r.ageGroup.resize( rows );
+        r.cohortSet.resize( rows ); r.species.resize( rows );
+        r.genotype.resize( rows ); r.drug.resize( rows );
+        r.measure.resize( rows ); r.value.resize( rows );
+        if( rows > 0 ){
+            check( om_copy_results( sim, &r.survey[0], &r.ageGroup[0],
+                    &r.cohortSet[0], &r.species[0], &r.genotype[0],
+                    &r.drug[0], &r.measure[0], &r.value[0] ), "om_copy_results" );
+        }
+        return r;
+    }
+}
+
+int main( int argc, char* argv[] ){
+    if( argc != 3 ){
+        fprintf( stderr, "Usage: %s SCENARIO RESOURCE_PATH\n", argv[0] );
+        return EXIT_FAILURE;
+    }
+    ifstream file( argv[1], ios::binary );
+    if( !file.is_open() ) fail( string( "unable to read " ).append( argv[1] ) );
+    ostringstream buf;
+    buf << file.rdbuf();
+    const string xml = buf.str();
+    const char* resourcePath = argv[2];
+    
+    // Run to the first survey, snapshot, then run to the end
+    om_simulation* sim = load( xml, resourcePath );
+    int finished = 0;
+    check( om_run_to_survey( sim, 1, &finished ), "om_run_to_survey" );
+    if( finished ) fail( "scenario ended before its first survey" );
+    char* state;
+    size_t stateLen;
+    check( om_snapshot( sim, &state, &stateLen ), "om_snapshot" );
+    const Results atSurvey = collect( sim );
+    check( om_run_to_end( sim ), "om_run_to_end" );
+    const Results atEnd = collect( sim );
+    if( atEnd.value.empty() ) fail( "no results" );
+    om_free( sim );
+    
+    // Restore the snapshot into a new simulation
+    sim = load( xml, resourcePath );
+    check( om_restore( sim, state, stateLen ), "om_restore" );
+    om_free_snapshot( state );
+    if( !(collect( sim ) == atSurvey) )
+        fail( "results differ after restoring the snapshot" );
+    check( om_run_to_end( sim ), "om_run_to_end" );
+    if( !(collect( sim ) == atEnd) )
+        fail( "final results differ after restoring the snapshot" );
+    om_free( sim );
+    
+    // A reloaded scenario starts from a clean state
+    sim = load( xml, resourcePath );
+    check( om_run_to_end( sim ), "om_run_to_end" );
+    if( !(collect( sim ) == atEnd) )
+        fail( "results differ when the scenario is loaded again" );
+    om_free( sim );
+    
+    return EXIT_SUCCESS;
+}
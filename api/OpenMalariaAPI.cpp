@@ -0,0 +1,284 @@
+/*
+ This file is part of OpenMalaria.
+
+ Copyright (C) 2005-2015 Swiss Tropical and Public Health Institute
+ Copyright (C) 2005-2015 Liverpool School Of Tropical Medicine
+
+ OpenMalaria is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or (at
+ your option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+#include "OpenMalariaAPI.h"
+
+#include "Global.h"
+#include "Simulator.h"
+#include "Population.h"
+#include "Monitoring/Continuous.h"
+#include "mon/info.h"
+#include "mon/management.h"
+#include "util/CommandLine.h"
+#include "util/DocumentLoader.h"
+#include "util/errors.h"
+#include "schema/scenario.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+using namespace OM;
+
+struct om_simulation {
+    om_simulation( unique_ptr<scnXml::Scenario> scenario, util::Checksum ck ) :
+        scenario(move(scenario)), cksum(ck), finished(false) {}
+
+    unique_ptr<scnXml::Scenario> scenario;
+    util::Checksum cksum;
+    // Constructed on first run, snapshot or restore (after parameter overrides)
+    unique_ptr<Simulator> simulator;
+    bool finished;
+    mon::SurveyColumns results;
+};
+
+namespace {
+    // Model state is static, so there can only be one simulation
+    om_simulation* current = 0;
+    bool commandLineParsed = false;
+    string lastError;
+
+    /** Call f, converting exceptions to an error code and message (as main()
+     * in openMalaria.cpp reports them). */
+    template<typename F>
+    int guarded( F f ){
+        lastError.clear();
+        try{
+            f();
+            return 0;
+        }catch( const ::xsd::cxx::tree::exception<char>& e ){
+            ostringstream msg;
+            msg << "XSD error: " << e.what() << '\n' << e;
+            lastError = msg.str();
+            return util::Error::XSD;
+        }catch( const util::base_exception& e ){
+            lastError = e.message();
+            return e.getCode();
+        }catch( const exception& e ){
+            lastError = e.what();
+            return EXIT_FAILURE;
+        }catch( ... ){
+            lastError = "Unknown error";
+            return EXIT_FAILURE;
+        }
+    }
+
+    void checkHandle( om_simulation* sim ){
+        if( sim == 0 || sim != current )
+            throw util::base_exception( "invalid simulation handle" );
+    }
+
+    /// Construct and initialise the simulator, if not already done.
+    void ensureStarted( om_simulation* sim, bool resume ){
+        if( sim->simulator.get() != 0 ){
+            if( resume )
+                throw util::base_exception( "om_restore: simulation has already started" );
+            return;
+        }
+        try{
+            sim->simulator.reset( new Simulator( sim->cksum, *sim->scenario ) );
+            sim->simulator->prepare( sim->scenario->getMonitoring(), resume );
+        }catch( ... ){
+            // allow another attempt (or another scenario) from a clean state
+            sim->simulator.reset();
+            Simulator::clearStatic();
+            throw;
+        }
+    }
+
+    void runTo( om_simulation* sim, SimTime endTime, int* finished ){
+        checkHandle( sim );
+        ensureStarted( sim, false );
+        if( !sim->finished && sim->simulator->run( endTime ) ){
+            // as in Simulator::start(), but output is left to the caller
+            sim::humanPop().flushReports();
+            Monitoring::Continuous.finalise();
+            sim->finished = true;
+        }
+        if( finished != 0 ) *finished = sim->finished ? 1 : 0;
+    }
+
+    template<typename T>
+    void copyColumn( const vector<T>& column, T* dest ){
+        if( dest != 0 && !column.empty() )
+            memcpy( dest, &column[0], column.size() * sizeof(T) );
+    }
+}
+
+extern "C" {
+
+om_simulation* om_load( const char* xml, size_t length, const char* resourcePath ){
+    om_simulation* result = 0;
+    guarded( [&](){
+        if( current != 0 )
+            throw util::base_exception( "om_load: only one simulation may exist at a time" );
+        util::set_gsl_handler();
+        if( !commandLineParsed ){
+            vector<string> args( 1, "openMalaria" );
+            if( resourcePath != 0 ){
+                args.push_back( "--resource-path" );
+                args.push_back( resourcePath );
+            }
+            vector<char*> argv;
+            for( size_t i = 0; i < args.size(); ++i )
+                argv.push_back( &args[i][0] );
+            util::CommandLine::parse( argv.size(), &argv[0] );
+            commandLineParsed = true;
+        }
+
+        istringstream stream( string( xml, length ) );
+        // The system identifier is used to find the schema (as when the
+        // document is loaded from the resource path by openMalaria).
+        unique_ptr<scnXml::Scenario> scenario = scnXml::parseScenario( stream,
+                util::CommandLine::lookupResource( "scenario.xml" ) );
+        util::Checksum cksum = util::Checksum::generate( stream );
+        if( scenario->getSchemaVersion() > util::DocumentLoader::SCHEMA_VERSION )
+            throw util::xml_scenario_error( "Error: new schema version unsupported" );
+
+        result = current = new om_simulation( move(scenario), cksum );
+    } );
+    return result;
+}
+
+int om_set_parameter( om_simulation* sim, const char* name, double value ){
+    return guarded( [&](){
+        checkHandle( sim );
+        if( sim->simulator.get() != 0 )
+            throw util::base_exception( "om_set_parameter: simulation has already started" );
+        scnXml::Parameters& params = sim->scenario->getModel().getParameters();
+        if( strcmp( name, "iseed" ) == 0 ){
+            params.setIseed( static_cast<int>( value ) );
+            return;
+        }
+        char* end;
+        long number = strtol( name, &end, 10 );
+        bool isNumber = *name != 0 && *end == 0;
+        foreach( scnXml::Parameter& param, params.getParameter() ){
+            if( (param.getName().present() && param.getName().get() == name)
+                || (isNumber && param.getNumber() == number) ){
+                param.setValue( value );
+                return;
+            }
+        }
+        throw util::xml_scenario_error( string( "om_set_parameter: no parameter " ).append( name ) );
+    } );
+}
+
+int om_run_until( om_simulation* sim, int days, int* finished ){
+    return guarded( [&](){
+        runTo( sim, SimTime::fromDays( days ), finished );
+    } );
+}
+
+int om_run_to_survey( om_simulation* sim, size_t survey, int* finished ){
+    return guarded( [&](){
+        checkHandle( sim );
+        ensureStarted( sim, false );    // survey times are read here
+        SimTime time = mon::reportedSurveyTime( survey );
+        if( time == SimTime::never() )
+            throw util::base_exception( "om_run_to_survey: no such survey" );
+        // The survey is concluded at the start of the step at its time
+        runTo( sim, time + sim::scenarioTS(), finished );
+    } );
+}
+
+int om_run_to_end( om_simulation* sim ){
+    return guarded( [&](){
+        runTo( sim, SimTime::future(), 0 );
+    } );
+}
+
+int om_collect_results( om_simulation* sim, size_t* rows ){
+    return guarded( [&](){
+        checkHandle( sim );
+        ensureStarted( sim, false );
+        mon::collectSurveyData( sim->results );
+        if( rows != 0 ) *rows = sim->results.rows();
+    } );
+}
+
+int om_copy_results( om_simulation* sim, uint32_t* survey, uint32_t* ageGroup,
+        uint32_t* cohortSet, uint32_t* species, uint32_t* genotype,
+        uint32_t* drug, int32_t* measure, double* value )
+{
+    return guarded( [&](){
+        checkHandle( sim );
+        const mon::SurveyColumns& res = sim->results;
+        copyColumn( res.surveys, survey );
+        copyColumn( res.ageGroups, ageGroup );
+        copyColumn( res.cohortSets, cohortSet );
+        copyColumn( res.speciesIds, species );
+        copyColumn( res.genotypes, genotype );
+        copyColumn( res.drugs, drug );
+        copyColumn( res.measures, measure );
+        copyColumn( res.values, value );
+    } );
+}
+
+int om_snapshot( om_simulation* sim, char** data, size_t* length ){
+    return guarded( [&](){
+        checkHandle( sim );
+        ensureStarted( sim, false );
+        ostringstream stream( ios::out | ios::binary );
+        sim->simulator->saveState( stream );
+        const string& state = stream.str();
+        *data = static_cast<char*>( malloc( state.size() ) );
+        if( *data == 0 ) throw bad_alloc();
+        memcpy( *data, state.data(), state.size() );
+        *length = state.size();
+    } );
+}
+
+void om_free_snapshot( char* data ){
+    free( data );
+}
+
+int om_restore( om_simulation* sim, const char* data, size_t length ){
+    return guarded( [&](){
+        checkHandle( sim );
+        ensureStarted( sim, true );
+        istringstream stream( string( data, length ), ios::in | ios::binary );
+        try{
+            sim->simulator->loadState( stream );
+        }catch( ... ){
+            // don't run from partially loaded state
+            sim->simulator.reset();
+            Simulator::clearStatic();
+            throw;
+        }
+    } );
+}
+
+const char* om_last_error( void ){
+    return lastError.c_str();
+}
+
+void om_free( om_simulation* sim ){
+    if( sim == 0 || sim != current ) return;
+    current = 0;
+    bool started = sim->simulator.get() != 0;
+    delete sim;
+    // static model state belongs to this simulation; free it so that another
+    // scenario (or the same one, e.g. to restore a snapshot) can be loaded
+    if( started ) Simulator::clearStatic();
+}
+
+}
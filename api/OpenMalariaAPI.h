@@ -0,0 +1,128 @@
+/*
+ This file is part of OpenMalaria.
+
+ Copyright (C) 2005-2015 Swiss Tropical and Public Health Institute
+ Copyright (C) 2005-2015 Liverpool School Of Tropical Medicine
+
+ OpenMalaria is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or (at
+ your option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* C interface to OpenMalaria, for embedding the simulator in other programs
+ * (e.g. calibration or optimisation drivers) without going through files and
+ * a process per run.
+ *
+ * Typical use:
+ *   om_simulation* sim = om_load( xml, xmlLen, "/path/to/resources" );
+ *   om_set_parameter( sim, "iseed", 7 );
+ *   om_run_to_survey( sim, 3, &finished );     // inspect results so far
+ *   om_snapshot( sim, &state, &stateLen );     // keep for later branching
+ *   om_run_until( sim, 3650, &finished );
+ *   om_collect_results( sim, &rows );
+ *   om_copy_results( sim, survey, 0, 0, 0, 0, 0, measure, value );
+ *   om_free( sim );
+ *
+ * Functions returning int return 0 on success or an OpenMalaria exit code
+ * (see model/util/errors.h) on failure; om_last_error() then describes the
+ * error.
+ *
+ * Limitations:
+ * - Model state is static: only one simulation may exist at a time in a
+ *   process (om_free it before loading another, which resets the static
+ *   state). Calls are not thread-safe.
+ * - The resource path (location of the schema and other input files) is set
+ *   by the first call to om_load and cannot change later.
+ * - om_restore only works on a simulation which has not yet been run.
+ * - Snapshots are only valid for the same scenario XML and library build;
+ *   parameter overrides are not verified on restore.
+ */
+
+#ifndef Hmod_OpenMalariaAPI
+#define Hmod_OpenMalariaAPI
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Opaque simulation handle. */
+typedef struct om_simulation om_simulation;
+
+/** Parse a scenario document from memory.
+ *
+ * @param xml Scenario XML (need not be NUL-terminated)
+ * @param length Length of xml in bytes
+ * @param resourcePath Directory containing the schema and other resources,
+ *  or NULL to use the working directory
+ * @returns A new simulation, or NULL on error */
+om_simulation* om_load( const char* xml, size_t length, const char* resourcePath );
+
+/** Override a model parameter before the simulation starts.
+ *
+ * name is matched against the name (or, if numeric, the number) of the
+ * scenario's model parameters; "iseed" sets the random seed. The parameter
+ * must already be described in the scenario. Only valid before the first
+ * run, snapshot or restore. */
+int om_set_parameter( om_simulation* sim, const char* name, double value );
+
+/** Run until intervention time reaches days (days since the start of the
+ * intervention period; the warm-up has negative times) or the simulation
+ * ends. *finished (if not NULL) is set to 1 if the end was reached. */
+int om_run_until( om_simulation* sim, int days, int* finished );
+
+/** Run until reported survey number survey (counting from 1, as in output)
+ * has been concluded, or the simulation ends. */
+int om_run_to_survey( om_simulation* sim, size_t survey, int* finished );
+
+/** Run to the end of the simulation. */
+int om_run_to_end( om_simulation* sim );
+
+/** Collect survey results so far into an internal buffer, and set *rows to
+ * the number of records. Values for surveys not yet concluded are zero.
+ * Until the simulation has finished, events of ongoing episodes have not yet
+ * been reported. */
+int om_collect_results( om_simulation* sim, size_t* rows );
+
+/** Copy collected results into caller-provided arrays of length at least
+ * rows (from om_collect_results). Columns are as in the binary output
+ * format; any pointer may be NULL to skip that column. */
+int om_copy_results( om_simulation* sim, uint32_t* survey, uint32_t* ageGroup,
+        uint32_t* cohortSet, uint32_t* species, uint32_t* genotype,
+        uint32_t* drug, int32_t* measure, double* value );
+
+/** Write complete simulation state to a new buffer (in checkpoint format).
+ * Free *data with om_free_snapshot. */
+int om_snapshot( om_simulation* sim, char** data, size_t* length );
+
+/** Free a buffer returned by om_snapshot. */
+void om_free_snapshot( char* data );
+
+/** Restore state written by om_snapshot of a simulation of the same
+ * scenario. sim must not have been run yet. */
+int om_restore( om_simulation* sim, const char* data, size_t length );
+
+/** Description of the last error (empty if none). Valid until the next call. */
+const char* om_last_error( void );
+
+/** Free a simulation. Another may then be loaded, e.g. to restore a snapshot
+ * of this one. Invalid handles are ignored. */
+void om_free( om_simulation* sim );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
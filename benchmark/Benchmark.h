@@ -0,0 +1,75 @@
+/*
+ This file is part of OpenMalaria.
+
+ Copyright (C) 2005-2015 Swiss Tropical and Public Health Institute
+ Copyright (C) 2005-2015 Liverpool School Of Tropical Medicine
+
+ OpenMalaria is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or (at
+ your option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+// Minimal micro-benchmark harness: times an operation and counts heap
+// allocations (via the replacement operator new in benchmarks.cpp).
+
+#ifndef Hmod_Benchmark
+#define Hmod_Benchmark
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstddef>
+
+namespace OM { namespace benchmark {
+
+/// Number of calls to operator new since program start
+extern size_t allocCount;
+
+struct Options {
+    Options() : minTime(0.5), filter("") {}
+    double minTime;     // minimum time (seconds) to run each benchmark
+    std::string filter; // only run benchmarks whose name contains this
+};
+
+/** Run op repeatedly, doubling the batch size until a batch takes at least
+ * opts.minTime, then print time and allocations per call.
+ *
+ * op is called once before timing (warm-up, e.g. for lazily sampled state). */
+inline void run( const Options& opts, const std::string& name,
+                 const std::function<void()>& op ){
+    if( name.find( opts.filter ) == std::string::npos ) return;
+    typedef std::chrono::steady_clock clock;
+
+    op();
+    size_t n = 1;
+    double secs;
+    size_t allocs;
+    while( true ){
+        size_t allocs0 = allocCount;
+        clock::time_point t0 = clock::now();
+        for( size_t i = 0; i < n; ++i ) op();
+        secs = std::chrono::duration<double>( clock::now() - t0 ).count();
+        allocs = allocCount - allocs0;
+        if( secs >= opts.minTime ) break;
+        n *= 2;
+    }
+    std::printf( "%-50s %12.1f ns/op %10.2f allocs/op %10zu ops\n",
+                 name.c_str(), secs * 1e9 / n,
+                 static_cast<double>(allocs) / n, n );
+    std::fflush( stdout );
+}
+
+} }
+#endif
@@ -0,0 +1,273 @@
+/*
+ This file is part of OpenMalaria.
+
+ Copyright (C) 2005-2015 Swiss Tropical and Public Health Institute
+ Copyright (C) 2005-2015 Liverpool School Of Tropical Medicine
+
+ OpenMalaria is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or (at
+ your option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+// Micro-benchmarks of the model's hot kernels. Usage:
+//   benchmark [FILTER] [--min-time SECONDS] [--pop N] [--scenario FILE]
+// The default scenario (test/scenarioGenotypes.xml) uses the vector model,
+// the Molineaux within-host model with PK/PD and two genotypes.
+// Only benchmarks whose name contains FILTER are run. Results are only
+// comparable between runs on the same machine and build type.
+
+#include "Global.h"
+#include "WithinHost/Infection/DummyInfection.h"
+#include "WithinHost/Infection/EmpiricalInfection.h"
+#include "WithinHost/Infection/PennyInfection.h"
+#include "WithinHost/Infection/MolineauxInfection.h"
+#include "WithinHost/CommonWithinHost.h"
+#include "util/AgeGroupInterpolation.h"
+#include "util/random.h"
+#include "util/errors.h"
+
+#include <cassert>
+// UnittestUtil.h uses this macro from ExtraAsserts.h (a cxxtest header):
+#define ETS_ASSERT( x ) assert( x )
+#include "UnittestUtil.h"
+#include "ModelFixture.h"
+#include "Benchmark.h"
+
+#include <boost/format.hpp>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+using namespace OM::benchmark;
+
+size_t OM::benchmark::allocCount = 0;
+
+// Count heap allocations. The array forms use these by default.
+void* operator new( size_t size ){
+    ++allocCount;
+    void* p = std::malloc( size == 0 ? 1 : size );
+    if( p == 0 ) throw std::bad_alloc();
+    return p;
+}
+void operator delete( void* p ) noexcept {
+    std::free( p );
+}
+
+namespace {
+    // Results are accumulated here so that the compiler can't drop calls
+    volatile double sink = 0.0;
+
+    const double NaN = numeric_limits<double>::quiet_NaN();
+
+    typedef CommonInfection* (*InfectionFactory)();
+
+    /** Update one infection daily; when it goes extinct a new one is created
+     * and the clock restarts, so that all stages of infections are included. */
+    void benchInfection( const Options& opts, const string& name,
+                         InfectionFactory create, double bodyMass ){
+        util::random::seed( 1095 );
+        unique_ptr<CommonInfection> inf( create() );
+        SimTime now = sim::ts0();
+        run( opts, name, [&](){
+            if( inf->update( 1.0, now, bodyMass ) ){
+                inf.reset( create() );
+                now = sim::ts0();
+            }else{
+                now += SimTime::oneDay();
+            }
+            sink += inf->getDensity();
+        } );
+    }
+
+    CommonInfection* createCommon(){
+        return CommonWithinHost::createInfection( 0xFFFFFFFF );
+    }
+    CommonInfection* createPenny(){
+        return new PennyInfection( 0xFFFFFFFF );
+    }
+    CommonInfection* createMolineaux(){
+        return new MolineauxInfection( 0xFFFFFFFF );
+    }
+
+    void benchInfections( const Options& opts ){
+        UnittestUtil::initTime( 1 );
+        UnittestUtil::Infection_init_latentP_and_NaN();
+        DummyInfection::init();
+        benchInfection( opts, "CommonInfection::update (dummy)", &createCommon, NaN );
+
+        EmpiricalInfection::init();     // reads autoRegressionParameters.csv
+        benchInfection( opts, "CommonInfection::update (empirical)", &createCommon, NaN );
+
+        PennyInfection::init();
+        benchInfection( opts, "CommonInfection::update (Penny)", &createPenny, NaN );
+
+        UnittestUtil::MolineauxWHM_setup( "original", false );
+        // adult body mass in kg to get 5l blood volume:
+        benchInfection( opts, "CommonInfection::update (Molineaux)", &createMolineaux, 71.43 );
+    }
+
+    /** Drug factor of one infection over a day with one dose taken at the
+     * start of the day (thus already in the blood) and another mid-day. */
+    void benchDrugFactor( const Options& opts, const char* abbrev, double mgPerKg,
+                          bool gaussLegendre ){
+        string name = string("LSTMModel::getDrugFactor (") + abbrev
+            + (gaussLegendre ? ", Gauss-Legendre)" : ")");
+        if( name.find( opts.filter ) == string::npos ) return;  // skip setup
+
+        UnittestUtil::initTime( 1 );
+        UnittestUtil::PkPdSuiteSetup( gaussLegendre );
+        {
+            const double bodyMass = 50;
+            PkPd::LSTMModel pkpd;
+            unique_ptr<CommonInfection> inf( createDummyInfection( 0 ) );
+            size_t drug = PkPd::LSTMDrugType::findDrug( abbrev );
+            UnittestUtil::medicate( pkpd, drug, mgPerKg * bodyMass, 0.0, bodyMass );
+            pkpd.decayDrugs( bodyMass );
+            UnittestUtil::medicate( pkpd, drug, mgPerKg * bodyMass, 0.5, bodyMass );
+            run( opts, name, [&](){
+                sink += pkpd.getDrugFactor( inf.get(), bodyMass );
+            } );
+        }
+        PkPd::LSTMDrugType::clear();
+    }
+
+    void benchDrugFactors( const Options& opts ){
+        for( int gl = 0; gl < 2; ++gl ){
+            // Gauss-Legendre integration only applies to the 3-compartment model
+            if( !gl ){
+                benchDrugFactor( opts, "MQ", 8.3, false );      // 1-compartment
+                benchDrugFactor( opts, "AR", 1.7, false );      // with conversion
+                benchDrugFactor( opts, "PPQ2", 18, false );     // 2-compartment
+            }
+            benchDrugFactor( opts, "PPQ3", 18, gl );            // 3-compartment
+        }
+    }
+
+    void benchAgeGroupInterpolator( const Options& opts ){
+        UnittestUtil::initTime( 5 );
+        const size_t dataLen = 5;
+        const double lbounds[dataLen] = { 0.0, 5.0, 10.0, 15.0, 60.0 };
+        const double values[dataLen] = { 0.0, 5.0, 10.0, 15.0, 60.0 };
+        scnXml::AgeGroupValues agv;
+        agv.getGroup().resize( dataLen, scnXml::Group( 0.0, 0.0 ) );
+        for( size_t i = 0; i < dataLen; ++i ){
+            agv.getGroup()[i].setLowerbound( lbounds[i] );
+            agv.getGroup()[i].setValue( values[i] );
+        }
+
+        const char* modes[] = { "none", "linear" };
+        for( size_t m = 0; m < 2; ++m ){
+            agv.setInterpolation( modes[m] );
+            util::AgeGroupInterpolator interp;
+            interp.set( agv, "benchmark" );
+            double age = 0.0;
+            run( opts, string("AgeGroupInterpolator::eval (") + modes[m] + ")", [&](){
+                sink += interp.eval( age );
+                age += 0.37;
+                if( age > 90.0 ) age -= 90.0;
+            } );
+        }
+    }
+
+    /// Benchmarks needing a whole model; these run last since they replace
+    /// all static model state.
+    void benchScenario( const Options& opts, const string& file, int popSize ){
+        ModelFixture fixture( file, popSize );
+        const string popDesc = (boost::format(" (%1% humans)") %sim::humanPop().size()).str();
+
+        if( dynamic_cast<Transmission::VectorModel*>( &sim::transmission() ) != 0 ){
+            run( opts, "VectorModel::vectorUpdate" + popDesc, [&](){
+                sim::transmission().vectorUpdate();
+            } );
+            run( opts, "AnophelesModel::advancePeriod (MosqTransmission::update)", [&](){
+                ModelFixture::advanceVectorSpecies( 0 );
+            } );
+        }
+
+        // One new infection per human every 8 steps gives a realistic
+        // multiplicity of infection once the population has been running a while.
+        vector<double> weights( WithinHost::Genotypes::N(), 1.0 );
+        size_t step = 0;
+        run( opts, "WHInterface::update, whole population" + popDesc, [&](){
+            int nNewInfs = (step % 8 == 0) ? 1 : 0;
+            for( Population::Iter it = sim::humanPop().begin(); it != sim::humanPop().end(); ++it ){
+                ModelFixture::updateWithinHost( *it, nNewInfs, weights );
+            }
+            ModelFixture::nextStep();
+            step += 1;
+        } );
+
+        mon::initMainSim();
+        Host::Human& human = *sim::humanPop().begin();
+        run( opts, "mon::reportStatMHI (Store::report)", [&](){
+            mon::reportStatMHI( mon::MHR_HOSTS, human, 1 );
+        } );
+
+        ostringstream checkpoint;
+        run( opts, "Population::checkpoint (write)" + popDesc, [&](){
+            checkpoint.str( string() );
+            sim::humanPop().checkpoint( checkpoint );
+        } );
+        const string data = checkpoint.str();
+        run( opts, "Population::checkpoint (read)" + popDesc, [&](){
+            istringstream is( data );
+            Population pop( 0 );
+            pop.checkpoint( is );
+        } );
+
+        // Initial sampling (before the main simulation), then with weights
+        // if the scenario uses tracking:
+        vector<double> noWeights;
+        run( opts, "Genotypes::sampleGenotype (initial)", [&](){
+            sink += WithinHost::Genotypes::sampleGenotype( noWeights );
+        } );
+        WithinHost::Genotypes::startMainSim();
+        for( size_t g = 0; g < weights.size(); ++g ) weights[g] = 1.0 + g;
+        run( opts, "Genotypes::sampleGenotype (main sim)", [&](){
+            sink += WithinHost::Genotypes::sampleGenotype( weights );
+        } );
+    }
+}
+
+int main( int argc, char* argv[] ){
+    Options opts;
+    int popSize = 0;    // 0: use the scenario's size
+    string scenarioFile = OM_BENCHMARK_SCENARIO;
+    for( int i = 1; i < argc; ++i ){
+        string arg = argv[i];
+        if( arg == "--min-time" && i + 1 < argc ){
+            opts.minTime = atof( argv[++i] );
+        }else if( arg == "--pop" && i + 1 < argc ){
+            popSize = atoi( argv[++i] );
+        }else if( arg == "--scenario" && i + 1 < argc ){
+            scenarioFile = argv[++i];
+        }else if( arg.size() > 0 && arg[0] != '-' && opts.filter.empty() ){
+            opts.filter = arg;
+        }else{
+            cerr << "Usage: " << argv[0]
+                << " [FILTER] [--min-time SECONDS] [--pop N] [--scenario FILE]" << endl;
+            return 1;
+        }
+    }
+
+    try{
+        benchInfections( opts );
+        benchDrugFactors( opts );
+        benchAgeGroupInterpolator( opts );
+        benchScenario( opts, scenarioFile, popSize );
+    }catch( const std::exception& e ){
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
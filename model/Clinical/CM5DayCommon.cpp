@@ -26,6 +26,7 @@
 #include "util/errors.h"
 #include "util/ModelOptions.h"
 #include "util/random.h"
+#include "util/MemoryStats.h"
 
 namespace OM {
 namespace Clinical {
@@ -58,6 +59,12 @@ CM5DayCommon::CM5DayCommon (double tSF) :
         m_treatmentSeekingFactor (tSF)
 {}
 
+void CM5DayCommon::reset (double tSF) {
+    ClinicalModel::reset( tSF );
+    m_tLastTreatment = SimTime::never();
+    m_treatmentSeekingFactor = tSF;
+}
+
 
 // ———  per-human, update  ———
 
@@ -196,6 +203,10 @@ void CM5DayCommon::severeMalaria (
 
 // ———  per-human, intervention & checkpointing  ———
 
+void CM5DayCommon::memoryStats( util::MemoryStats& stats ) const{
+    stats.add( "clinical model (5-day)", 1, sizeof(*this) );
+}
+
 void CM5DayCommon::checkpoint (istream& stream) {
     ClinicalModel::checkpoint (stream);
     m_tLastTreatment & stream;
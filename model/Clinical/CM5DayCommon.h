@@ -46,11 +46,15 @@ public:
      */
     CM5DayCommon (double tSF);
     
+    virtual void reset (double tSF);
+    
     virtual bool isExistingCase () {
         // If treated in the recent past:
         return sim::now() > m_tLastTreatment && sim::now() <= m_tLastTreatment + healthSystemMemory;
     }
     
+    virtual void memoryStats( util::MemoryStats& stats ) const;
+    
 protected:
     enum CaseType { FirstLine, SecondLine, NumCaseTypes };
     static mon::Measure measures[NumCaseTypes];
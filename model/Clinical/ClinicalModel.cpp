@@ -110,6 +110,11 @@ ClinicalModel::~ClinicalModel () {
   // latestReport is reported, if any, by destructor
 }
 
+void ClinicalModel::reset (double) {
+    latestReport.flush();       // normally nothing left to report
+    doomed = NOT_DOOMED;
+}
+
 
 // -----  other non-static methods  -----
 
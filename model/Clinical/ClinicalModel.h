@@ -29,7 +29,11 @@ namespace scnXml{
     class Scenario;
     class HealthSystem;
 }
-namespace OM { namespace Clinical {
+namespace OM {
+namespace util {
+    class MemoryStats;
+}
+namespace Clinical {
     using Host::Human;
 
 /** The clinical model models the effects of sickness dependant on malarial
@@ -86,12 +90,19 @@ public:
      * (within health-system-memory and not new cases). */
     virtual bool isExistingCase() =0;
     
+    /// Add memory used by this object to stats
+    virtual void memoryStats( util::MemoryStats& stats ) const =0;
+    
     /// Force all pending summaries to be reported. Should only be called when
     /// class is about to be destroyed anyway to avoid affecting output.
     inline void flushReports (){
         latestReport.flush();
     }
     
+    /** Return to the state of a new model with treatment seeking factor tSF,
+     * for reuse by a new human. Call flushReports() first. */
+    virtual void reset (double tSF);
+    
     /// Checkpointing
     template<class S>
     void operator& (S& stream) {
@@ -26,6 +26,7 @@
 #include "util/ModelOptions.h"
 #include "util/errors.h"
 #include "util/StreamValidator.h"
+#include "util/MemoryStats.h"
 #include <schema/scenario.h>
 
 #include <limits>
@@ -104,6 +105,7 @@ void ClinicalEventScheduler::setParameters(const scnXml::HSEventScheduler& esDat
             "Clinical outcomes: constraints on case/risk/memory duration not met (see documentation)");
     }
     
+    cumDailyPrImmUCTS.clear();
     cumDailyPrImmUCTS.reserve( coData.getDailyPrImmUCTS().size() );
     double cumP = 0.0;
     for( scnXml::ClinicalOutcomes::DailyPrImmUCTSConstIterator it = coData.getDailyPrImmUCTS().begin(); it != coData.getDailyPrImmUCTS().end(); ++it ){
@@ -151,6 +153,16 @@ ClinicalEventScheduler::ClinicalEventScheduler (double tSF) :
     }
 }
 
+void ClinicalEventScheduler::reset (double tSF) {
+    assert( tSF == 1.0 );       // checked by constructor
+    ClinicalModel::reset( tSF );
+    pgState = Episode::NONE;
+    caseStartTime = SimTime::never();
+    timeOfRecovery = SimTime::never();
+    timeLastTreatment = SimTime::never();
+    previousDensity = numeric_limits<double>::quiet_NaN();
+}
+
 
 // -----  other methods  -----
 
@@ -159,6 +171,10 @@ bool ClinicalEventScheduler::isExistingCase() {
         return sim::now() > timeLastTreatment && sim::now() <= timeLastTreatment + healthSystemMemory;
 }
 
+void ClinicalEventScheduler::memoryStats( util::MemoryStats& stats ) const{
+    stats.add( "clinical model (event scheduler)", 1, sizeof(*this) );
+}
+
 void ClinicalEventScheduler::doClinicalUpdate (Human& human, double ageYears){
     WHInterface& withinHostModel = *human.withinHostModel;
     // Run pathogenesisModel
@@ -168,7 +184,7 @@ void ClinicalEventScheduler::doClinicalUpdate (Human& human, double ageYears){
     Episode::State newState = static_cast<Episode::State>( pg.state );
     util::streamValidate( (newState << 16) & pgState );
     
-    if ( sim::ts0() == timeOfRecovery ) {
+    if ( sim::inCurrentStep( timeOfRecovery ) ) {
 	if( pgState & Episode::DIRECT_DEATH ){
 	    // Human dies this time step (last day of risk of death)
 	    doomed = DOOMED_COMPLICATED;
@@ -241,7 +257,7 @@ void ClinicalEventScheduler::doClinicalUpdate (Human& human, double ageYears){
             doomed = -SimTime::oneTS().inDays(); // start indirect mortality countdown
     }
     
-    if( caseStartTime == sim::ts0() && (pgState & Episode::RUN_CM_TREE) ){
+    if( sim::inCurrentStep( caseStartTime ) && (pgState & Episode::RUN_CM_TREE) ){
         // OK, we're about to run the CM tree
         pgState = Episode::State (pgState & ~Episode::RUN_CM_TREE);
         
@@ -379,7 +395,8 @@ void ClinicalEventScheduler::doClinicalUpdate (Human& human, double ageYears){
 		if (random::uniform_01() < pDeath) {
 		    pgState = Episode::State (pgState | Episode::DIRECT_DEATH);
 		    // Human is killed at end of time at risk
-		    timeOfRecovery += extraDaysAtRisk;	// may be re-set later (see ATORWD)
+		    // (not before the next step: see COARSE_WARMUP)
+		    timeOfRecovery = max( timeOfRecovery + extraDaysAtRisk, sim::ts1() );	// may be re-set later (see ATORWD)
 		}
 	    }
 	    previousDensity = withinHostModel.getTotalDensity();
@@ -388,7 +405,7 @@ void ClinicalEventScheduler::doClinicalUpdate (Human& human, double ageYears){
     
     // Start of case. Not necessarily start of sickness due to treatment-seeking
     // delays and travel time.
-    if( caseStartTime == sim::ts0() ){
+    if( sim::inCurrentStep( caseStartTime ) ){
 	// Patients in hospital are removed from the transmission cycle.
 	// This should have an effect from the start of the next time step.
 	// NOTE: This is not very accurate, but considered of little importance.
@@ -408,6 +425,10 @@ void ClinicalEventScheduler::doClinicalUpdate (Human& human, double ageYears){
 	} else {
 	    timeOfRecovery = sim::ts0() + uncomplicatedCaseDuration;
 	}
+	// Recovery is checked on later steps. With a 1-day step this has no
+	// effect; with the coarse steps of COARSE_WARMUP, recovery happens at
+	// the end of the step in which it falls.
+	timeOfRecovery = max( timeOfRecovery, sim::ts1() );
     }
     
     // Remove on first models...
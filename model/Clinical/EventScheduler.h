@@ -49,7 +49,11 @@ public:
 
     ClinicalEventScheduler (double tSF);
     
+    virtual void reset (double tSF);
+    
     virtual bool isExistingCase();
+    
+    virtual void memoryStats( util::MemoryStats& stats ) const;
 
 protected:
     virtual void doClinicalUpdate (Human& human, double ageYears);
@@ -28,8 +28,10 @@
 #include "Transmission/TransmissionModel.h"
 #include "PopulationStats.h"
 #include "util/ModelOptions.h"
+#include "util/random.h"
 #include "util/vectors.h"
 #include "util/StreamValidator.h"
+#include "util/MemoryStats.h"
 #include "Population.h"
 #include "interventions/InterventionManager.hpp"
 #include "mon/reporting.h"
@@ -40,11 +42,21 @@ namespace OM { namespace Host {
     using interventions::ComponentId;
     
     bool surveyOnlyNewEp = false;
+    
+    // Sub-models shared by all placeholder humans. These are taken from the
+    // first human made a placeholder, thus no extra random numbers are drawn.
+    unique_ptr<InfectionIncidenceModel> placeholderIncidence;
+    unique_ptr<WithinHost::WHInterface> placeholderWHM;
+    unique_ptr<Clinical::ClinicalModel> placeholderCM;
 
 // -----  Static functions  -----
 
 void Human::init( const Parameters& parameters, const scnXml::Scenario& scenario ){    // static
     HumanHet::init();
+    // models from a previous initialisation may have other parameters:
+    placeholderIncidence.reset();
+    placeholderWHM.reset();
+    placeholderCM.reset();
     surveyOnlyNewEp = scenario.getMonitoring().getSurveyOptions().getOnlyNewEpisode();
     
     const scnXml::Model& model = scenario.getModel();
@@ -55,15 +67,23 @@ void Human::init( const Parameters& parameters, const scnXml::Scenario& scenario
     Clinical::ClinicalModel::init( parameters, scenario );
 }
 
+void Human::staticChangeTimeStep( SimTime oldTS ){
+    WithinHost::WHInterface::staticChangeTimeStep();
+    if( placeholderWHM.get() != 0 )
+        placeholderWHM->changeTimeStep( oldTS );
+}
+
 
 // -----  Non-static functions: creation/destruction, checkpointing  -----
 
 // Create new human
-Human::Human(SimTime dateOfBirth) :
+Human::Human(SimTime dateOfBirth, uint32_t birthIndex) :
     infIncidence(InfectionIncidenceModel::createModel()),
     m_DOB(dateOfBirth),
+    m_birthIndex(birthIndex),
     m_cohortSet(0),
-    nextCtsDist(0)
+    nextCtsDist(0),
+    m_subPopNextExp(SimTime::future())
 {
     // Initial humans are created at time 0 and may have DOB in past. Otherwise DOB must be now.
     assert( m_DOB == sim::nowOrTs1() || (sim::now() == SimTime::zero() && m_DOB < sim::now()) );
@@ -79,16 +99,81 @@ Human::Human(SimTime dateOfBirth, int dummy) :
     infIncidence(0),
     clinicalModel(0),
     m_DOB(dateOfBirth),
+    m_birthIndex(0),
     m_cohortSet(0),
-    nextCtsDist(0)
+    nextCtsDist(0),
+    m_subPopNextExp(SimTime::future())
 {}
 
 void Human::destroy() {
+    if( isPlaceholder() ) return;       // models are shared
     delete infIncidence;
     delete withinHostModel;
     delete clinicalModel;
 }
 
+void Human::retire() {
+    assert( !isPlaceholder() );
+    clinicalModel->flushReports();
+}
+
+void Human::reset( SimTime dateOfBirth, uint32_t birthIndex ){
+    m_DOB = dateOfBirth;
+    assert( m_DOB == sim::nowOrTs1() );
+    m_birthIndex = birthIndex;
+    m_cohortSet = 0;
+    nextCtsDist = 0;
+    monitoringAgeGroup = mon::AgeGroup();
+    m_subPopExp.clear();
+    m_subPopNextExp = SimTime::future();
+    _vaccine.reset();
+    perHostTransmission.reset();
+    infIncidence->reset();
+    
+    // Sample in the same order as the constructor:
+    HumanHet het = HumanHet::sample();
+    withinHostModel->reset( het.comorbidityFactor );
+    perHostTransmission.initialise (het.availabilityFactor * infIncidence->getAvailabilityFactor(1.0));
+    clinicalModel->reset (het.treatmentSeekingFactor);
+}
+
+void Human::makePlaceholder(){
+    if( isPlaceholder() ) return;
+    if( placeholderWHM.get() == 0 ){
+        placeholderIncidence.reset( infIncidence );
+        placeholderWHM.reset( withinHostModel );
+        placeholderCM.reset( clinicalModel );
+    }else{
+        delete infIncidence;
+        delete withinHostModel;
+        delete clinicalModel;
+    }
+    infIncidence = placeholderIncidence.get();
+    withinHostModel = placeholderWHM.get();
+    clinicalModel = placeholderCM.get();
+}
+
+bool Human::isPlaceholder() const{
+    return withinHostModel != 0 && withinHostModel == placeholderWHM.get();
+}
+
+void Human::changeTimeStep( SimTime oldTS ){
+    if( isPlaceholder() ) return;
+    withinHostModel->changeTimeStep( oldTS );
+}
+
+void Human::materialise(){
+    // Not expected in a normal run: placeholders are only made of humans who
+    // die before their first update. Heterogeneity factors are resampled
+    // (availability is kept), so this does not reproduce the human created in
+    // full.
+    util::random::SubStream stream( util::random::HOST_INIT, getID(), 1 );
+    HumanHet het = HumanHet::sample();
+    infIncidence = InfectionIncidenceModel::createModel();
+    withinHostModel = WithinHost::WHInterface::createWithinHostModel( het.comorbidityFactor );
+    clinicalModel = Clinical::ClinicalModel::createClinicalModel (het.treatmentSeekingFactor);
+}
+
 
 // -----  Non-static functions: per-time-step update  -----
 
@@ -102,6 +187,12 @@ bool Human::update(bool doUpdate) {
 #endif
     // For integer age checks we use age0 to e.g. get 73 steps comparing less than 1 year old
     SimTime age0 = age(sim::ts0());
+    if( isPlaceholder() ){
+        // Equivalent to isDead() for a model which was never updated (which
+        // we can't call since it changes the shared model's state):
+        if( !doUpdate ) return age0 >= sim::maxHumanAge();
+        materialise();
+    }
     if (clinicalModel->isDead(age0))
         return true;
     
@@ -115,29 +206,27 @@ bool Human::update(bool doUpdate) {
         // monitoringAgeGroup is the group for the start of the time step.
         monitoringAgeGroup.update( age0 );
         // check sub-pop expiry
-        for( map<ComponentId,SimTime>::iterator expIt =
-            m_subPopExp.begin(), expEnd = m_subPopExp.end(); expIt != expEnd; )
+        if( m_subPopNextExp < sim::ts0() ) expireSubPops();
+        // ageYears1 used only in PerHost::relativeAvailabilityAge(); difference to age0 should be minor
+        // Each process has its own random sub-stream (only used with
+        // COMMON_RANDOM_NUMBERS)
+        double EIR;
+        int nNewInfs;
         {
-            if( !(expIt->second >= sim::ts0()) ){       // membership expired
-                // don't flush reports
-                // report removal due to expiry
-                mon::reportEventMHI( mon::MHR_SUB_POP_REM_TOO_OLD, *this, 1 );
-                m_cohortSet = mon::updateCohortSet( m_cohortSet, expIt->first, false );
-                // erase element, but continue iteration
-                expIt = m_subPopExp.erase( expIt );
-            }else{
-                ++expIt;
-            }
+            util::random::SubStream stream( util::random::INFECTION_INCIDENCE, getID() );
+            EIR = sim::transmission().getEIR( *this, age0, ageYears1,
+                    EIR_per_genotype );
+            nNewInfs = infIncidence->numNewInfections( *this, EIR );
         }
-        // ageYears1 used only in PerHost::relativeAvailabilityAge(); difference to age0 should be minor
-        double EIR = sim::transmission().getEIR( *this, age0, ageYears1,
-                EIR_per_genotype );
-        int nNewInfs = infIncidence->numNewInfections( *this, EIR );
         
-        // ageYears1 used when medicating drugs (small effect) and in immunity model (which was parameterised for it)
-        withinHostModel->update(nNewInfs, EIR_per_genotype, ageYears1,
-                _vaccine.getFactor(interventions::Vaccine::BSV));
+        {
+            util::random::SubStream stream( util::random::WITHIN_HOST, getID() );
+            // ageYears1 used when medicating drugs (small effect) and in immunity model (which was parameterised for it)
+            withinHostModel->update(nNewInfs, EIR_per_genotype, ageYears1,
+                    _vaccine.getFactor(interventions::Vaccine::BSV));
+        }
         
+        util::random::SubStream stream( util::random::CASE_MANAGEMENT, getID() );
         // ageYears1 used to get case fatality and sequelae probabilities, determine pathogenesis
         clinicalModel->update( *this, ageYears1, age0 == SimTime::zero() );
         clinicalModel->updateInfantDeaths( age0 );
@@ -145,6 +234,23 @@ bool Human::update(bool doUpdate) {
     return false;
 }
 
+void Human::expireSubPops(){
+    m_subPopNextExp = SimTime::future();
+    for( size_t i = 0; i < m_subPopExp.size(); ++i ){
+        SimTime expiry = m_subPopExp[i];
+        if( expiry == SimTime::never() ) continue;      // not a member
+        if( expiry < sim::ts0() ){      // membership expired
+            // don't flush reports
+            // report removal due to expiry
+            mon::reportEventMHI( mon::MHR_SUB_POP_REM_TOO_OLD, *this, 1 );
+            m_cohortSet = mon::updateCohortSet( m_cohortSet, ComponentId(i), false );
+            m_subPopExp[i] = SimTime::never();
+        }else{
+            m_subPopNextExp = min( m_subPopNextExp, expiry );
+        }
+    }
+}
+
 void Human::addInfection(){
     withinHostModel->importInfection();
 }
@@ -154,11 +260,29 @@ void Human::clearImmunity(){
 }
 
 
-void Human::summarize() {
+void Human::memoryStats( util::MemoryStats& stats ) const{
+    if( isPlaceholder() ){
+        // sub-models are shared (and negligible)
+        stats.add( "human (placeholder)", 1, sizeof(Human) );
+        perHostTransmission.memoryStats( stats );
+        return;
+    }
+    stats.add( "human", 1, sizeof(Human) );
+    stats.add( "sub-population membership", m_subPopExp.size(),
+               util::MemoryStats::bytes( m_subPopExp ) );
+    // subclasses add no data
+    stats.add( "infection incidence model", 1, sizeof(InfectionIncidenceModel) );
+    clinicalModel->memoryStats( stats );
+    withinHostModel->memoryStats( stats );
+    perHostTransmission.memoryStats( stats );
+    _vaccine.memoryStats( stats );
+}
+
+bool Human::summarizeReports() {
     if( surveyOnlyNewEp && clinicalModel->isExistingCase() ){
         // This modifies the denominator to treat the health-system-memory
         // period immediately after a bout as 'not at risk'.
-        return;
+        return false;
     }
     
     mon::reportStatMHI( mon::MHR_HOSTS, *this, 1 );
@@ -166,23 +290,30 @@ void Human::summarize() {
     bool patent = withinHostModel->summarize (*this);
     infIncidence->summarize (*this);
     
-    if( patent && mon::isReported() ){
-        // this should happen after all other reporting!
-        removeFirstEvent( interventions::SubPopRemove::ON_FIRST_INFECTION );
-    }
+    // removal should happen after all other reporting!
+    return patent && mon::isReported();
+}
+
+void Human::endSummary() {
+    removeFirstEvent( interventions::SubPopRemove::ON_FIRST_INFECTION );
 }
 
 void Human::reportDeployment( ComponentId id, SimTime duration ){
     if( duration <= SimTime::zero() ) return; // nothing to do
-    m_subPopExp[id] = sim::nowOrTs1() + duration;
+    if( id.id >= m_subPopExp.size() ){
+        m_subPopExp.resize( max( interventions::InterventionManager::numComponents(),
+                                 id.id + 1 ), SimTime::never() );
+    }
+    SimTime expiry = sim::nowOrTs1() + duration;
+    m_subPopExp[id.id] = expiry;
+    m_subPopNextExp = min( m_subPopNextExp, expiry );
     m_cohortSet = mon::updateCohortSet( m_cohortSet, id, true );
 }
 void Human::removeFirstEvent( interventions::SubPopRemove::RemoveAtCode code ){
     const vector<ComponentId>& removeAtList = interventions::removeAtIds[code];
     for( vector<ComponentId>::const_iterator it = removeAtList.begin(), end = removeAtList.end(); it != end; ++it ){
-        SubPopT::iterator expIt = m_subPopExp.find( *it );
-        if( expIt != m_subPopExp.end() ){
-            if( expIt->second > sim::nowOrTs0() ){
+        if( it->id < m_subPopExp.size() && m_subPopExp[it->id] != SimTime::never() ){
+            if( m_subPopExp[it->id] > sim::nowOrTs0() ){
                 // removeFirstEvent() is used for onFirstBout, onFirstTreatment
                 // and onFirstInfection cohort options. Health system memory must
                 // be reset for this to work properly; in theory the memory should
@@ -192,9 +323,9 @@ void Human::removeFirstEvent( interventions::SubPopRemove::RemoveAtCode code ){
                 // report removal due to first infection/bout/treatment
                 mon::reportEventMHI( mon::MHR_SUB_POP_REM_FIRST_EVENT, *this, 1 );
             }
-            m_cohortSet = mon::updateCohortSet( m_cohortSet, expIt->first, false );
+            m_cohortSet = mon::updateCohortSet( m_cohortSet, *it, false );
             // remove (affects reporting, restrictToSubPop and cumulative deployment):
-            m_subPopExp.erase( expIt );
+            m_subPopExp[it->id] = SimTime::never();
         }
     }
 }
@@ -29,6 +29,7 @@
 #include <map>
 
 class UnittestUtil;
+class ModelFixture;
 namespace scnXml {
     class Scenario;
 }
@@ -52,8 +53,9 @@ public:
   //@{
   /** Initialise all variables of a human datatype.
    * 
-   * \param dateOfBirth date of birth (usually start of next time step) */
-  Human(SimTime dateOfBirth);
+   * \param dateOfBirth date of birth (usually start of next time step)
+   * \param birthIndex Index among humans born on dateOfBirth (see getID()) */
+  Human(SimTime dateOfBirth, uint32_t birthIndex);
 
   /** Destructor
    * 
@@ -65,6 +67,36 @@ public:
   /// The real destructor
   void destroy();
   
+  /** Alternative to destroy() for a dead human whose object will be reused
+   * via reset(): reports anything pending, as destruction would. Not for
+   * placeholders. */
+  void retire();
+  
+  /** Reuse a retired human's object and sub-models (and their allocated
+   * memory) for a new human born at dateOfBirth. The result, including
+   * the random numbers drawn, is the same as constructing a new Human. */
+  void reset( SimTime dateOfBirth, uint32_t birthIndex );
+  
+  /** Turn this human into a placeholder: replace its infection incidence,
+   * within-host and clinical models with instances shared by all
+   * placeholders, freeing its own.
+   * 
+   * This is for humans which will never be updated (those who die during the
+   * ONE_LIFE_SPAN warm-up before updates start). The state of their
+   * sub-models never changes from the initial (uninfected, untreated) state,
+   * which is identical for all humans as far as other code can observe, so
+   * sharing it saves memory without changing results. A placeholder which
+   * does get updated is given new models first. */
+  void makePlaceholder();
+  
+  /// True if this human uses shared placeholder sub-models
+  bool isPlaceholder() const;
+  
+  /** Convert state stored per time step after the time-step length changed
+   * from oldTS to SimTime::oneTS() (model option COARSE_WARMUP). Does nothing
+   * for placeholders (see staticChangeTimeStep). */
+  void changeTimeStep( SimTime oldTS );
+  
   /// Checkpointing
   template<class S>
   void operator& (S& stream) {
@@ -75,11 +107,13 @@ public:
       (*withinHostModel) & stream;
       (*clinicalModel) & stream;
       m_DOB & stream;
+      m_birthIndex & stream;
       _vaccine & stream;
       monitoringAgeGroup & stream;
       m_cohortSet & stream;
       nextCtsDist & stream;
       m_subPopExp & stream;
+      m_subPopNextExp & stream;
   }
   //@}
   
@@ -98,7 +132,8 @@ public:
   void reportDeployment( interventions::ComponentId id, SimTime duration );
   
   inline void removeFromSubPop( interventions::ComponentId id ){
-      m_subPopExp.erase( id );
+      if( id.id < m_subPopExp.size() )
+          m_subPopExp[id.id] = SimTime::never();
   }
   
   /// Resets immunity
@@ -114,14 +149,26 @@ public:
     inline SimTime age( SimTime time )const{ return time - m_DOB; }
     /** Date of birth. */
     inline SimTime getDateOfBirth() const{ return m_DOB; }
+    /** Identifier unique within the population, made of the date of birth
+     * and the index among humans born on that date; keys this human's random
+     * sub-streams (model option COMMON_RANDOM_NUMBERS). Unlike a count of
+     * all births, it does not depend on how many humans died earlier, so
+     * it is the same in scenarios differing only in interventions. */
+    inline uint64_t getID() const{ return makeID( m_DOB, m_birthIndex ); }
+    /** The identifier of a human born at dateOfBirth with index birthIndex
+     * (see getID()). */
+    static inline uint64_t makeID( SimTime dateOfBirth, uint32_t birthIndex ){
+        return static_cast<uint64_t>( static_cast<uint32_t>( dateOfBirth.raw() ) ) << 32
+            | birthIndex;
+    }
   
   /** Return true if human is a member of the sub-population.
    * 
    * @param id Sub-population identifier. */
   inline bool isInSubPop( interventions::ComponentId id )const{
-      map<interventions::ComponentId,SimTime>::const_iterator it = m_subPopExp.find( id );
-      if( it == m_subPopExp.end() ) return false;       // no history of membership
-      else return it->second > sim::nowOrTs0();   // added: has expired?
+      // no history of membership gives never(), which is in the past
+      return id.id < m_subPopExp.size() &&
+          m_subPopExp[id.id] > sim::nowOrTs0();     // added: has expired?
   }
   /** Return the cohort set. */
   inline uint32_t cohortSet()const{ return m_cohortSet; }
@@ -136,7 +183,23 @@ public:
   //@}
   
   //! Summarize the state of a human individual.
-  void summarize();
+  inline void summarize(){
+      if( summarizeReports() ) endSummary();
+  }
+  
+  /** The reporting part of summarize(), which does not modify state of other
+   * humans or models, thus may be called concurrently for different humans
+   * if reports are buffered (see mon::ReportBuffer).
+   * 
+   * Returns true if endSummary() must be called (after all reports of this
+   * human are stored). */
+  bool summarizeReports();
+  
+  /// Apply sub-population removal on first infection; see summarizeReports().
+  void endSummary();
+  
+  /// Add memory used by this human and its sub-models to stats
+  void memoryStats( util::MemoryStats& stats ) const;
   
   /** Act on "remove from sub-population on first ..." events.
    *
@@ -169,6 +232,10 @@ public:
   
   /// Initialise human-specific models
   static void init( const OM::Parameters& parameters, const scnXml::Scenario& scenario );
+  
+  /** Adjust static parameters after the time-step length changed from oldTS
+   * to SimTime::oneTS(), and convert shared placeholder models. */
+  static void staticChangeTimeStep( SimTime oldTS );
     
 public:
   /** @brief Models
@@ -186,6 +253,9 @@ private:
   /// Param 'dummy' isn't used but is just to allow overloading against usual constructor
   Human(SimTime dateOfBirth, int dummy);
   
+  /// Give a placeholder its own sub-models (samples new heterogeneity factors)
+  void materialise();
+  
   /// The InfectionIncidenceModel translates per-host EIR into new infections
   InfectionIncidenceModel *infIncidence;
   
@@ -196,6 +266,7 @@ private:
   //@}
   
   SimTime m_DOB;        // date of birth; humans are always born at the end of a time step
+  uint32_t m_birthIndex;        // see getID()
   
   /// Vaccines
   interventions::PerHumanVaccine _vaccine;
@@ -211,23 +282,30 @@ private:
   /// The next continuous distribution in the series
   uint32_t nextCtsDist;
   
-  //TODO(optimisation): it might be better to instead store for each
-  // ComponentId of interest the set of humans who are members
-  typedef std::map<interventions::ComponentId,SimTime> SubPopT;
-  /** This lists sub-populations of which the human is a member together with
-   * expiry time.
+  /// Remove memberships which expired before this step, reporting them
+  void expireSubPops();
+  
+  /** Expiry time of membership of each sub-population, indexed by
+   * ComponentId, or SimTime::never() if not a member. Empty until the first
+   * deployment with a duration, then sized for all components.
    * 
-   * Definition: a human is in sub-population p if m_subPopExp.contains(p) and,
-   * for t=m_subPopExp[p], t > sim::now() (at the time of intervention
+   * Definition: a human is in sub-population p if, for
+   * t=m_subPopExp[p], t > sim::now() (at the time of intervention
    * deployment) or t > sim::ts0() (equiv t >= sim::ts1()) during human update.
    * 
    * NOTE: this discrepancy is because intervention deployment effectively
    * happens at the end of a time step and we want a duration of 1 time step to
    * mean 1 intervention deployment (that where the human becomes a member) and
    * 1 human update (the next). */
-  SubPopT m_subPopExp;
+  vector<SimTime> m_subPopExp;
+  
+  /** Earliest expiry time in m_subPopExp (excluding never()), or
+   * SimTime::future() if none: until then update() need not check for
+   * expired memberships. May be earlier than needed after a removal. */
+  SimTime m_subPopNextExp;
   
   friend class ::UnittestUtil;
+  friend class ::ModelFixture;
 };
 
 } }
@@ -21,6 +21,7 @@
 #include "Host/ImportedInfections.h"
 #include "Host/Human.h"
 #include "util/random.h"
+#include "util/ModelOptions.h"
 #include "util/timeConversions.h"
 #include "Population.h"
 
@@ -88,8 +89,12 @@ void ImportedInfections::import( Population& population ){
     
     double rateNow = rate[lastIndex].value;
     if( rateNow > 0.0 ){
+        util::random::BernoulliSequence select( rateNow,
+                util::ModelOptions::option( util::GEOMETRIC_SKIP_SAMPLING ) );
         for(Population::Iter it = population.begin(); it!=population.end(); ++it){
-            if(util::random::bernoulli( rateNow )){
+            // salt 1: distinct from the human's own incidence stream
+            util::random::SubStream stream( util::random::INFECTION_INCIDENCE, it->getID(), 1 );
+            if( select.next() ){
                 it->addInfection();
             }
         }
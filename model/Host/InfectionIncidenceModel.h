@@ -75,6 +75,12 @@ protected:
 public:
   virtual ~InfectionIncidenceModel() {}
   
+  /// Return to the state of a new model (subclasses have no other data)
+  inline void reset() {
+      m_pInfected = 0.0;
+      m_cumulativeEIRa = 0.0;
+  }
+  
   /** Return an availability multiplier, dependant on the model (NegBinomMAII
    * and LogNormalMAII models use this). Ideally availability adjustments
    * should have nothing to do with the InfectionIncidenceModel though.
@@ -24,6 +24,8 @@
 #include "WithinHost/Diagnostic.h"
 #include "util/random.h"
 #include "util/CommandLine.h"
+#include "util/vectors.h"
+#include "util/ModelOptions.h"
 #include "schema/healthSystem.h"
 
 #include <cmath>
@@ -58,9 +60,14 @@ SimTime ageLb = SimTime::fromYearsI(20), ageUb = SimTime::fromYearsI(25);
 const WithinHost::Diagnostic* neonatalDiagnostic = 0;
 
 
+/// Length of the prevByGestationalAge buffer
+inline size_t gestationSteps(){
+    return SimTime::fromDays( 5 * 30 ).inSteps();
+}
+
+
 void NeonatalMortality::init( const scnXml::Clinical& clinical ){
-    SimTime fiveMonths = SimTime::fromDays( 5 * 30 );
-    prevByGestationalAge.assign( fiveMonths.inSteps(), 0.0 );
+    prevByGestationalAge.assign( gestationSteps(), 0.0 );
     
     if( clinical.getNeonatalMortality().present() ){
         neonatalDiagnostic = &WithinHost::diagnostics::get(
@@ -85,30 +92,57 @@ void NeonatalMortality::staticCheckpoint (ostream& stream) {
     prevByGestationalAge & stream;
 }
 
+void NeonatalMortality::changeTimeStep( SimTime oldTS ){
+    vector<size_t> indices = vectors::changeTSIndices(
+            prevByGestationalAge.size(), oldTS,
+            gestationSteps(), SimTime::oneTS(), sim::latestTs0() );
+    vector<double> prev( indices.size() );
+    for( size_t i = 0; i < indices.size(); ++i )
+        prev[i] = prevByGestationalAge[indices[i]];
+    prevByGestationalAge.swap( prev );
+}
+
 bool NeonatalMortality::eventNeonatalMortality() {
   return random::uniform_01() <= riskFromMaternalInfection;
 }
 
+bool NeonatalMortality::canCountMothersInUpdate(){
+    return neonatalDiagnostic->isDeterministic() &&
+        !ModelOptions::option( VIVAX_SIMPLE_MODEL );
+}
+
+void NeonatalMortality::countMother (const Human& human, SimTime age,
+        int& n, int& nPatent)
+{
+    if( age < ageLb || age >= ageUb ) return;
+    n ++;
+    if( human.getWithinHostModel().diagnosticResult(*neonatalDiagnostic) ){
+        nPatent ++;
+    }
+}
+
 void NeonatalMortality::update (const Population& population) {
     // ———  find potential mothers and their prevalence  ———
     // For individuals in the age range 20-25, we sum:
     int nCounter=0;	// total number
     int pCounter=0;	// number with patent infections, needed for prev in 20-25y
     
-    for(Population::ConstIter iter = population.cbegin(); iter != population.cend(); ++iter){
-        // diagnosticDefault() gives patency after the last time step's
-        // update, so it's appropriate to use age at the beginning of this step.
-        SimTime age = iter->age(sim::ts0());
-        
-        // Note: since we're using a linked list, we have to iterate until we reach
-        // the individuals we're interested in. Due to population structure, it's
-        // probably quickest to start iterating from the oldest.
-        if( age >= ageUb ) continue;
-        if( age < ageLb ) break;	// Not interested in younger individuals.
-        
-        nCounter ++;
-        if( iter->withinHostModel->diagnosticResult(*neonatalDiagnostic) ){
-            pCounter ++;
+    // Counts from the last step's update use ages at its end, our ts0.
+    const Population::HostStats& stats = population.hostStats();
+    if( stats.time == sim::ts0() && stats.countMothers ){
+        nCounter = stats.nMothers;
+        pCounter = stats.nPatentMothers;
+    }else{
+        for(Population::ConstIter iter = population.cbegin(); iter != population.cend(); ++iter){
+            // diagnosticDefault() gives patency after the last time step's
+            // update, so it's appropriate to use age at the beginning of this step.
+            SimTime age = iter->age(sim::ts0());
+            
+            // Note: since we're using a linked list, we have to iterate until we reach
+            // the individuals we're interested in. Due to population structure, it's
+            // probably quickest to start iterating from the oldest.
+            if( age < ageLb ) break;	// Not interested in younger individuals.
+            countMother( *iter, age, nCounter, pCounter );
         }
     }
     
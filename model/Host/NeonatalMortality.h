@@ -29,6 +29,7 @@ namespace scnXml {
 namespace OM {
     class Population;
 namespace Host {
+    class Human;
 
 class NeonatalMortality {
 public:
@@ -38,12 +39,29 @@ public:
   static void staticCheckpoint (istream& stream);
   static void staticCheckpoint (ostream& stream);
   
+  /** Convert the stored prevalences after the time-step length changed from
+   * oldTS to SimTime::oneTS(). Call between updates. */
+  static void changeTimeStep( SimTime oldTS );
+  
   /** Called for each birth; returns true if infant dies due to mother's
    * infection. */
   static bool eventNeonatalMortality();
   
-  /** Calculate risk of a neonatal mortality based on humans 20-25 years old. */
+  /** Calculate risk of a neonatal mortality based on humans 20-25 years old.
+   * 
+   * Uses counts collected during the last step's human update
+   * (Population::HostStats) when available, otherwise sweeps the population. */
   static void update (const Population& population);
+  
+  /** True if potential mothers can be counted during the previous step's
+   * human update. Requires a deterministic diagnostic (otherwise random
+   * draws would be reordered) and that patency does not change between
+   * updates (vivax treatment clears broods immediately). */
+  static bool canCountMothersInUpdate();
+  
+  /** If human is a potential mother at the given age, increment n, and
+   * nPatent if she has a patent infection. */
+  static void countMother (const Human& human, SimTime age, int& n, int& nPatent);
 };
 
 } }
@@ -32,6 +32,9 @@
 #include <vector>
 #include <map>
 #include <fstream>
+#include <sstream>
+#include <limits>
+#include <algorithm>
 #include <boost/format.hpp>
 #include <gzstream/gzstream.h>
 
@@ -57,6 +60,68 @@ namespace OM { namespace Monitoring {
     streamoff streamOff;
     streampos streamStart;
     
+    /* Rows are assembled in rowStream, then appended to ctsBuffer, which is
+     * only written to ctsOStream once it grows beyond bufferFlushSize (and
+     * before checkpointing and at the end of the simulation). This replaces
+     * a flushed write per row with a few large writes. */
+    ostringstream rowStream;
+    string ctsBuffer;
+    const size_t bufferFlushSize = 1 << 16;
+    
+    /* Binary mode (--ctsout-binary): a header followed by fixed-width rows of
+     * one little-endian double per column; see util/compareCtsout.py. */
+    bool binaryMode = false;
+    size_t nColumns = 0;
+    const uint32_t bin_BOM = 0x54434D4F;    // "OMCT" in little-endian: OpenMalaria ConTinuous output
+    const uint32_t bin_version = 1;
+    
+    template<typename T>
+    void binaryAppend( string& buf, T x ){
+        buf.append( reinterpret_cast<const char*>(&x), sizeof(x) );
+    }
+    
+    /* In binary mode rowStream uses this facet: numbers written by callbacks
+     * are appended to ctsBuffer as doubles instead of being formatted; only
+     * the separating tabs reach rowStream (and are discarded). */
+    class binary_num_put : public num_put<char> {
+    protected:
+        virtual iter_type do_put( iter_type out, ios_base&, char_type, long v ) const{
+            return append( out, v );
+        }
+        virtual iter_type do_put( iter_type out, ios_base&, char_type, unsigned long v ) const{
+            return append( out, v );
+        }
+        virtual iter_type do_put( iter_type out, ios_base&, char_type, long long v ) const{
+            return append( out, v );
+        }
+        virtual iter_type do_put( iter_type out, ios_base&, char_type, unsigned long long v ) const{
+            return append( out, v );
+        }
+        virtual iter_type do_put( iter_type out, ios_base&, char_type, double v ) const{
+            return append( out, v );
+        }
+        virtual iter_type do_put( iter_type out, ios_base&, char_type, long double v ) const{
+            return append( out, v );
+        }
+    private:
+        template<typename T>
+        iter_type append( iter_type out, T v ) const{
+            binaryAppend( ctsBuffer, static_cast<double>(v) );
+            return out;
+        }
+    };
+    
+    /** Write out buffered rows and update the checkpoint position. */
+    void flushBuffer(){
+        if( ctsBuffer.empty() ) return;
+        util::BoincWrapper::beginCriticalSection();     // see comment in checkpoint (istream&)
+        ctsOStream.write( ctsBuffer.data(), ctsBuffer.size() );
+        ctsOStream.flush();
+        streamOff = ctsOStream.tellp() - streamStart;
+        util::BoincWrapper::endCriticalSection();
+        ctsBuffer.clear();
+    }
+    
     // List of all registered callbacks (not used after init() runs)
     class Callback {
     protected:
@@ -97,9 +162,20 @@ namespace OM { namespace Monitoring {
     
     ContinuousType::~ContinuousType (){
         // free memory
+        clear();
+   }
+   
+    void ContinuousType::clear (){
         toReport.clear();
         for( registered_t::iterator it = registered.begin(); it != registered.end(); ++it )
             delete it->second;
+        registered.clear();
+        if( ctsOStream.is_open() ) ctsOStream.close();
+        ctsOStream.clear();
+        ctsBuffer.clear();
+        ctsPeriod = SimTime::zero();
+        duringInit = false;
+        nColumns = 0;
    }
    
     /* Initialise: enable outputs registered and requested in XML.
@@ -135,18 +211,30 @@ namespace OM { namespace Monitoring {
 	locale nfn_put_locale(old_locale, new boost::math::nonfinite_num_put<char>);
 	ctsOStream.imbue( nfn_put_locale );
 	ctsOStream.width (0);
+	binaryMode = util::CommandLine::option( util::CommandLine::CTSOUT_BINARY );
+	if( binaryMode ){
+	    rowStream.imbue( locale(old_locale, new binary_num_put) );
+	}else{
+	    rowStream.imbue( nfn_put_locale );
+	}
 	
-	if( isCheckpoint ){
-	    scnXml::OptionSet::OptionSequence sOSeq = ctsOpt.get().getOption();
-	    for(scnXml::OptionSet::OptionConstIterator it = sOSeq.begin(); it != sOSeq.end(); ++it) {
-		registered_t::const_iterator reg_it = registered.find( it->getName() );
-		if( reg_it == registered.end() )
-		    throw xml_scenario_error( (boost::format("monitoring.continuous: no output \"%1%\"") %it->getName() ).str() );
-		if( it->getValue() ){
-		    toReport.push_back( reg_it->second );
-		}
+	string titles;
+	if( duringInit )
+	    titles = "simulation time\t";
+	titles += "timestep";   //TODO: change to days or remove or leave?
+	scnXml::OptionSet::OptionSequence sOSeq = ctsOpt.get().getOption();
+	for(scnXml::OptionSet::OptionConstIterator it = sOSeq.begin(); it != sOSeq.end(); ++it) {
+	    registered_t::const_iterator reg_it = registered.find( it->getName() );
+	    if( reg_it == registered.end() )
+		throw xml_scenario_error( (boost::format("monitoring.continuous: no output \"%1%\"") %it->getName() ).str() );
+	    if( it->getValue() ){
+		titles += reg_it->second->titles;
+		toReport.push_back( reg_it->second );
 	    }
-	    
+	}
+	nColumns = count( titles.begin(), titles.end(), '\t' ) + 1;
+	
+	if( isCheckpoint ){
 	    // When loading a check-point, we resume reporting to this file.
 	    // Use "ate" mode and seek to desired pos.
 	    ctsOStream.open (cts_filename.c_str(), ios::binary|ios::ate|ios::in|ios::out );
@@ -166,29 +254,40 @@ namespace OM { namespace Monitoring {
 	    
 	    ctsOStream.open( cts_filename.c_str(), ios::binary|ios::out );
 	    streamStart = ctsOStream.tellp();
-	    ctsOStream << "##\t##" << endl;	// live-graph needs a deliminator specifier when it's not a comma
 	    
-	    if( duringInit )
-                ctsOStream << "simulation time\t";
-	    ctsOStream << "timestep";   //TODO: change to days or remove or leave?
-	    scnXml::OptionSet::OptionSequence sOSeq = ctsOpt.get().getOption();
-	    for(scnXml::OptionSet::OptionConstIterator it = sOSeq.begin(); it != sOSeq.end(); ++it) {
-		registered_t::const_iterator reg_it = registered.find( it->getName() );
-		if( reg_it == registered.end() )
-		    throw xml_scenario_error( (boost::format("monitoring.continuous: no output \"%1%\"") %it->getName() ).str() );
-		if( it->getValue() ){
-		    ctsOStream << reg_it->second->titles;
-		    toReport.push_back( reg_it->second );
+	    if( binaryMode ){
+		// Header: BOM, format version, number of columns, then the
+		// length-prefixed name of each column.
+		vector<string> names;
+		size_t pos = 0;
+		while( true ){
+		    size_t next = titles.find( '\t', pos );
+		    names.push_back( titles.substr( pos, next - pos ) );
+		    if( next == string::npos ) break;
+		    pos = next + 1;
+		}
+		assert( names.size() == nColumns );
+		binaryAppend( ctsBuffer, bin_BOM );
+		binaryAppend( ctsBuffer, bin_version );
+		binaryAppend( ctsBuffer, static_cast<uint32_t>(nColumns) );
+		foreach( const string& name, names ){
+		    binaryAppend( ctsBuffer, static_cast<uint8_t>(name.size()) );
+		    ctsBuffer.append( name, 0, 255 );
 		}
+	    }else{
+		ctsBuffer = "##\t##";	// live-graph needs a deliminator specifier when it's not a comma
+		ctsBuffer.push_back( mon::lineEnd );
+		ctsBuffer.append( titles );
+		ctsBuffer.push_back( mon::lineEnd );
 	    }
-	    ctsOStream << mon::lineEnd << flush;
-	    streamOff = ctsOStream.tellp() - streamStart;
+	    flushBuffer();
 	}
     }
    
    void ContinuousType::finalise() {
          if( ctsPeriod == SimTime::zero() )
              return;     // output disabled
+        flushBuffer();
 #ifndef WITHOUT_BOINC
         if (util::BoincWrapper::fileExists(compressedCtsoutName.c_str())){
             throw util::base_exception(string("File ").append(compressedCtsoutName).append(" exists!"),util::Error::FileExists);
@@ -206,6 +305,8 @@ namespace OM { namespace Monitoring {
         if( ctsPeriod == SimTime::zero() )
             return;	// output disabled
 	
+	// Rows up to now must be in the file before we record its position
+	flushBuffer();
 	streamOff & stream;
     }
     void ContinuousType::checkpoint (istream& stream){
@@ -218,8 +319,9 @@ namespace OM { namespace Monitoring {
 	 * (b) trying to avoid kills during writing of a line, by using
 	 *  BOINC critical sections.
 	 * 
-	 * (Keeping results in memory until end of sim would be another,
-	 * slightly safer, option, but loses real-time output.) */
+	 * (Rows are buffered in memory between large writes, but the buffer is
+	 * always written before checkpointing, so only whole rows up to the
+	 * checkpoint are covered by streamOff.) */
 	streamOff & stream;
 	// We skip back to the last write-point, so anything written after the
 	// last checkpoint will be repeated:
@@ -241,31 +343,48 @@ namespace OM { namespace Monitoring {
     }
     
     void ContinuousType::update (const Population& population){
-        if( ctsPeriod == SimTime::zero() )
-            return;	// output disabled
-        if( !duringInit ){
-            if( sim::intervNow() < SimTime::zero() || mod_nn(sim::intervNow(), ctsPeriod) != SimTime::zero() )
-                return;
-        } else {
-            if( mod_nn(sim::now(), ctsPeriod) != SimTime::zero() )
-                return;
-            ctsOStream << sim::now().inSteps() << '\t';
-        }
-	
-	util::BoincWrapper::beginCriticalSection();	// see comment in staticCheckpoint
+        if( !isReportTime( sim::now(), sim::intervNow() ) )
+            return;
 	
+#ifndef NDEBUG
+	const size_t rowStart = ctsBuffer.size();
+#endif
+	rowStream.str( string() );
+	if( duringInit )
+	    rowStream << sim::now().inSteps() << '\t';
         if( duringInit && sim::intervNow() < SimTime::zero() ){
-            ctsOStream << "nan";
+            if( binaryMode ) rowStream << numeric_limits<double>::quiet_NaN();
+            else rowStream << "nan";
         }else{
-            ctsOStream << sim::intervNow().inSteps();
+            rowStream << sim::intervNow().inSteps();
         }
 	for( size_t i = 0; i < toReport.size(); ++i )
-	    toReport[i]->call( population, ctsOStream );
-	// We must flush often to avoid temporarily outputting partial lines
-	// (resulting in incorrect real-time graphs).
-	ctsOStream << mon::lineEnd << flush;
+	    toReport[i]->call( population, rowStream );
+	if( binaryMode ){
+	    // values were appended directly by binary_num_put
+	    assert( ctsBuffer.size() - rowStart == nColumns * sizeof(double) );  // callback wrote wrong number of values?
+	}else{
+	    ctsBuffer.append( rowStream.str() );
+	    ctsBuffer.push_back( mon::lineEnd );
+	}
 	
-	streamOff = ctsOStream.tellp() - streamStart;
-	util::BoincWrapper::endCriticalSection();
+	// Only whole rows are ever written, so no partial lines are output.
+	if( ctsBuffer.size() >= bufferFlushSize )
+	    flushBuffer();
+    }
+    
+    bool ContinuousType::isReportTime (SimTime now, SimTime intervNow) const{
+        if( ctsPeriod == SimTime::zero() )
+            return false;	// output disabled
+        if( !duringInit ){
+            return intervNow >= SimTime::zero() && mod_nn(intervNow, ctsPeriod) == SimTime::zero();
+        } else {
+            return mod_nn(now, ctsPeriod) == SimTime::zero();
+        }
+    }
+    bool ContinuousType::isEnabled (const string& optName){
+        registered_t::const_iterator it = registered.find( optName );
+        if( it == registered.end() ) return false;
+        return find( toReport.begin(), toReport.end(), it->second ) != toReport.end();
     }
 } }
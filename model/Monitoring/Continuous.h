@@ -37,12 +37,19 @@ namespace Monitoring {
      * Requirements:
      *  (1) frequency of and which data is output should be controllable
      *  (2) format should be compatible with LiveGraph and (German) Excel.
+     *  (3) output is buffered in memory and written in large chunks; with
+     *      --ctsout-binary a binary format of doubles is written instead.
      */
     class ContinuousType {
     public:
         // frees memory
         ~ContinuousType();        
         
+        /** Free registered callbacks and close output, returning to the
+         * state before any callback was registered (so that another
+         * simulation can be set up in the same process). */
+        void clear();
+        
 	/** Load XML description of options. If resuming from a checkpoint,
 	 * append to output; if not, make sure it's not there (on boinc we
 	 * assume we shouldn't overwrite existing files for security reasons).
@@ -50,8 +57,8 @@ namespace Monitoring {
 	 * Callbacks should be registered before init() is called. */
 	void init (const scnXml::Monitoring& monitoring, bool isCheckpoint);
         
-        /** When compiled in BOINC mode, this copies data to the final
-         * compressing output file. Otherwise it does nothing. */
+        /** Writes out any buffered rows. When compiled in BOINC mode, this
+         * also copies data to the final compressing output file. */
         void finalise();
         
         /// Checkpointing
@@ -76,6 +83,16 @@ namespace Monitoring {
         /// As above, except that the called delegate is passed a reference to the Population object
         void registerCallback (string optName, string titles, fastdelegate::FastDelegate2<const Population&, ostream&>);
 	
+	/** Return true if the output registered as optName was enabled in XML.
+	 * 
+	 * Only meaningful after init(). Callbacks sharing work (e.g. a sweep over
+	 * the population) can use this to skip unneeded work. */
+	bool isEnabled (const string& optName);
+	
+	/** Return true if update() will produce output when called at a time
+	 * with these values of sim::now() and sim::intervNow(). */
+	bool isReportTime (SimTime now, SimTime intervNow) const;
+	
 	/// Generate time-step's output. Called at beginning of time step.
         /// Passed population since some callbacks use this to generate output.
 	void update (const Population& population);
@@ -81,6 +81,14 @@ public:
      * @param body_mass Weight of patient in kg */
     virtual void updateConcentration (double body_mass) =0;
     
+    /** True when the concentration has fallen below the negligible level (and
+     * been zeroed) and no doses are pending; updateConcentration() then does
+     * nothing. */
+    virtual bool isCleared() const =0;
+    
+    /// Memory used by this object, including doses, in bytes
+    virtual size_t memoryBytes() const =0;
+    
     /// Checkpointing
     template<class S>
     void operator& (S& stream) {
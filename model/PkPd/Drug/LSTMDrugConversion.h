@@ -54,6 +54,12 @@ public:
     
     virtual double calculateDrugFactor(WithinHost::CommonInfection *inf, double body_mass) const;
     virtual void updateConcentration (double body_mass);
+    virtual bool isCleared() const{
+        return qtyG == 0.0 && qtyP == 0.0 && qtyM == 0.0 && doses.empty();
+    }
+    virtual size_t memoryBytes() const{
+        return sizeof(*this) + doses.capacity() * sizeof(DoseVec::value_type);
+    }
     double getMetaboliteConcentration() const;
     double getParentConcentration() const;
     
@@ -52,6 +52,12 @@ public:
     
     virtual double calculateDrugFactor(WithinHost::CommonInfection *inf, double body_mass) const;
     virtual void updateConcentration (double body_mass);
+    virtual bool isCleared() const{
+        return concentration == 0.0 && doses.empty();
+    }
+    virtual size_t memoryBytes() const{
+        return sizeof(*this) + doses.capacity() * sizeof(DoseVec::value_type);
+    }
     
 protected:
     virtual void checkpoint (istream& stream);
@@ -21,6 +21,7 @@
 #include "PkPd/Drug/LSTMDrugThreeComp.h"
 #include "WithinHost/Infection/CommonInfection.h"
 #include "util/errors.h"
+#include "util/ModelOptions.h"
 #include "util/StreamValidator.h"
 
 #include <boost/math/constants/constants.hpp>
@@ -31,6 +32,13 @@ using namespace std;
 
 namespace OM { namespace PkPd {
 
+bool LSTMDrugThreeComp::useGaussLegendre = false;
+size_t LSTMDrugThreeComp::gaussLegendreIntegrals = 0;
+
+void LSTMDrugThreeComp::init(){
+    useGaussLegendre = util::ModelOptions::option( util::LSTM_PKPD_GAUSS_LEGENDRE );
+}
+
 LSTMDrugThreeComp::LSTMDrugThreeComp(const LSTMDrugType& type) :
     LSTMDrug(type.sample_Vd()),
     typeData(type),
@@ -133,19 +141,55 @@ const size_t GSL_INTG_MAX_ITER = 1000;     // 10 seems enough, but no harm in us
 gsl_integration_workspace *gsl_intgr_wksp = gsl_integration_workspace_alloc (GSL_INTG_MAX_ITER);
 //NOTE: we "should" free, but mem-leaks at end of program aren't really important
 // gsl_integration_workspace_free (gsl_intgr_wksp);
+// NOTE: tolerances are arbitrary, but seem to be sufficient
+const double INTG_ABS_EPS = 1e-2, INTG_REL_EPS = 1e-2;
+
+// Gauss-Legendre nodes and weights on [-1,1] for the positive half of the
+// symmetric 3- and 6-point rules (3-point has an extra node at 0).
+const double GL3_X = 0.7745966692414834, GL3_W = 0.5555555555555556, GL3_W0 = 0.8888888888888889;
+const double GL6_X[3] = { 0.2386191860831969, 0.6612093864662645, 0.9324695142031521 };
+const double GL6_W[3] = { 0.4679139345726910, 0.3607615730481386, 0.1713244923791704 };
+
+bool LSTMDrugThreeComp::integrateGL(const Params_fC& p, double duration, double& intfC){
+    // The integrand is a Hill function of a sum of exponentials, hence smooth
+    // over each dose-free segment. The 6-point rule is accepted when it
+    // agrees with the 3-point rule to within the QAG tolerances (the
+    // difference bounds the error of the lower-order rule).
+    void* pp = static_cast<void*>(const_cast<Params_fC*>(&p));
+    const double h = 0.5 * duration;
+    
+    double i6 = 0.0;
+    for( size_t i = 0; i < 3; ++i ){
+        i6 += GL6_W[i] * (func_fC(h - h * GL6_X[i], pp) + func_fC(h + h * GL6_X[i], pp));
+    }
+    i6 *= h;
+    const double i3 = h * (GL3_W0 * func_fC(h, pp) +
+            GL3_W * (func_fC(h - h * GL3_X, pp) + func_fC(h + h * GL3_X, pp)));
+    
+    const double err = fabs(i6 - i3);
+    // negated test so that NaN falls back to QAG
+    if( !(err <= max(INTG_ABS_EPS, INTG_REL_EPS * fabs(i6))) ) return false;
+    intfC = i6;
+    return true;
+}
+
 double LSTMDrugThreeComp::calculateFactor(const Params_fC& p, double duration) const{
+    double intfC;
+    if( useGaussLegendre && integrateGL(p, duration, intfC) ){
+        gaussLegendreIntegrals += 1;
+        return 1.0 / exp( intfC );  // drug factor
+    }
+    
     gsl_function F;
     F.function = &func_fC;
     // gsl_function doesn't accept const; we re-apply const later
     F.params = static_cast<void*>(const_cast<Params_fC*>(&p));
     
-    // NOTE: tolerances are arbitrary, but seem to be sufficient
-    const double abs_eps = 1e-2, rel_eps = 1e-2;
     // NOTE: 1 through 6 are different algorithms of increasing complexity
     const int qag_rule = 1;     // alg 1 seems to be good enough
-    double intfC, err_eps;
+    double err_eps;
     
-    int r = gsl_integration_qag (&F, 0.0, duration, abs_eps, rel_eps,
+    int r = gsl_integration_qag (&F, 0.0, duration, INTG_ABS_EPS, INTG_REL_EPS,
                                  GSL_INTG_MAX_ITER, qag_rule, gsl_intgr_wksp, &intfC, &err_eps);
     if( r != 0 ){
         throw TRACED_EXCEPTION( "calculateFactor: error from gsl_integration_qag",util::Error::GSL );
@@ -48,6 +48,14 @@ public:
     /** Create a new instance. */
     LSTMDrugThreeComp (const LSTMDrugType&);
     
+    /** Read model options affecting all instances. Called by
+     * LSTMDrugType::init(). */
+    static void init();
+    
+    /// Number of daily integrals done by Gauss-Legendre quadrature (i.e.
+    /// without falling back to QAG); for testing
+    static size_t gaussLegendreIntegrals;
+    
     virtual size_t getIndex() const;
     virtual double getConcentration(size_t index) const;
     
@@ -55,6 +63,12 @@ public:
     
     virtual double calculateDrugFactor(WithinHost::CommonInfection *inf, double body_mass) const;
     virtual void updateConcentration (double body_mass);
+    virtual bool isCleared() const{
+        return conc() == 0.0 && doses.empty();
+    }
+    virtual size_t memoryBytes() const{
+        return sizeof(*this) + doses.capacity() * sizeof(DoseVec::value_type);
+    }
     
 protected:
     virtual void checkpoint (istream& stream);
@@ -90,6 +104,14 @@ protected:
 private:
     double calculateFactor(const Params_fC& p, double duration) const;
     
+    /** Integrate func_fC over [0, duration] with fixed-order Gauss-Legendre
+     * quadrature. Returns false (leaving intfC unchanged) when the error
+     * estimate exceeds tolerance, in which case QAG should be used. */
+    static bool integrateGL(const Params_fC& p, double duration, double& intfC);
+    
+    /// True when LSTM_PKPD_GAUSS_LEGENDRE is enabled
+    static bool useGaussLegendre;
+    
     friend double func_fC( double t, void* pp );        // function used in calculateFactor
 };
 
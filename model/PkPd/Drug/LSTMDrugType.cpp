@@ -30,6 +30,7 @@
 #include <schema/pharmacology.h>
 
 #include <cmath>
+#include <cassert>
 #include <boost/ptr_container/ptr_vector.hpp>
 #include <boost/format.hpp>
 
@@ -49,6 +50,9 @@ DrugTypesT drugTypes;
 map<string,size_t> drugTypeNames;
 // List of all indices of drugs being used
 vector<size_t> drugsInUse;
+// For each drug type index, its position in drugsInUse (or NOT_IN_USE)
+const size_t NOT_IN_USE = numeric_limits<size_t>::max();
+vector<size_t> drugInUseSlot;
 
 
 LSTMDrugPD::LSTMDrugPD( const scnXml::Phenotype& phenotype ){
@@ -73,18 +77,24 @@ double LSTMDrugPD::calcFactor( double Kn, double neg_elim_rate, double* conc, do
 }
 
 double LSTMDrugPD::IC50_pow_slope(size_t index, WithinHost::CommonInfection *inf) const{
-    double Kn;  // gets sampled once per infection
-    if (inf->Kn.count(index) != 0) {
-        Kn = inf->Kn.at(index);
-    } else {
+    // Kn gets sampled once per infection; storage is indexed by position in
+    // drugsInUse and grown lazily (NaN means not yet sampled).
+    assert( index < drugInUseSlot.size() && drugInUseSlot[index] != NOT_IN_USE );
+    const size_t slot = drugInUseSlot[index];
+    if( slot >= inf->Kn.size() ){
+        inf->Kn.resize( drugsInUse.size(), numeric_limits<double>::quiet_NaN() );
+    }
+    double& Kn = inf->Kn[slot];
+    if( (boost::math::isnan)(Kn) ){
         Kn = pow(IC50.sample(), n);
-        inf->Kn[index] = Kn;
     }
     return Kn;
 }
 
 
 void LSTMDrugType::init (const scnXml::Pharmacology::DrugsType& drugData) {
+    LSTMDrugThreeComp::init();
+    
     foreach( const scnXml::PKPDDrug& drug, drugData.getDrug() ){
         const string& abbrev = drug.getAbbrev();
         // Check drug doesn't already exist
@@ -100,6 +110,8 @@ void LSTMDrugType::clear()
 {
     drugTypes.clear();
     drugTypeNames.clear();
+    drugsInUse.clear();
+    drugInUseSlot.clear();
 }
 
 size_t LSTMDrugType::numDrugTypes(){
@@ -111,6 +123,9 @@ void drugIsUsed(size_t index){
     foreach( size_t i, drugsInUse ){
         if( i == index ) return;        // already in list
     }
+    if( drugInUseSlot.size() <= index )
+        drugInUseSlot.resize( drugTypes.size(), NOT_IN_USE );
+    drugInUseSlot[index] = drugsInUse.size();
     drugsInUse.push_back(index);
 }
 size_t LSTMDrugType::findDrug(string _abbreviation) {
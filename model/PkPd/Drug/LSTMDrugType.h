@@ -101,7 +101,8 @@ public:
     //@{
     /** Initialise the drug model. Called at start of simulation. */
     static void init (const scnXml::Drugs& data);
-    /** Clear previous data. Only needed for testing. */
+    /** Clear previous data. Needed for testing and before setting up
+     * another simulation in the same process. */
     static void clear();
     
     /** Get the number of drug types. */
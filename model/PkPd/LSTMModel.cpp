@@ -26,6 +26,7 @@
 #include "mon/reporting.h"
 #include "util/checkpoint_containers.h"
 #include "util/errors.h"
+#include "util/MemoryStats.h"
 
 #include "schema/scenario.h"
 
@@ -44,6 +45,12 @@ void LSTMModel::init( const scnXml::Scenario& scenario ){
 
 // ———  non-static set up / tear down functions  ———
 
+void LSTMModel::reset() {
+    m_drugs.clear();
+    m_drugPos.assign( m_drugPos.size(), 0 );
+    medicateQueue.clear();
+}
+
 void LSTMModel::checkpoint (istream& stream) {
     size_t numDrugs;	// type must be same as m_drugs.size()
     numDrugs & stream;
@@ -53,6 +60,8 @@ void LSTMModel::checkpoint (istream& stream) {
         index & stream;
         m_drugs.push_back( LSTMDrugType::createInstance(index) );
         m_drugs.back() & stream;
+        if( m_drugPos.size() <= index ) m_drugPos.resize( index + 1, 0 );
+        m_drugPos[index] = m_drugs.size();
     }
     medicateQueue & stream;
 }
@@ -98,16 +107,19 @@ void LSTMModel::medicate(double body_mass){
 }
 
 void LSTMModel::medicateDrug(size_t typeIndex, double qty, double time, double bodyMass) {
-    //TODO: might be a little faster if m_drugs was pre-allocated with a slot for each drug type, using a null pointer
-    foreach( LSTMDrug& drug, m_drugs ){
-        if (drug.getIndex() == typeIndex){
-            drug.medicate (time, qty, bodyMass);
-            return;
-        }
+    if( m_drugPos.size() <= typeIndex ){
+        m_drugPos.resize( LSTMDrugType::numDrugTypes(), 0 );
+        assert( typeIndex < m_drugPos.size() );
+    }
+    uint32_t pos = m_drugPos[typeIndex];
+    if( pos == 0 ){
+        // No instance yet, so insert one:
+        m_drugs.push_back( LSTMDrugType::createInstance(typeIndex) );
+        pos = m_drugs.size();
+        m_drugPos[typeIndex] = pos;
     }
-    // No match, so insert one:
-    m_drugs.push_back( LSTMDrugType::createInstance(typeIndex) );
-    m_drugs.back().medicate (time, qty, bodyMass);
+    assert( m_drugs[pos-1].getIndex() == typeIndex );
+    m_drugs[pos-1].medicate (time, qty, bodyMass);
 }
 
 double LSTMModel::getDrugConc (size_t drug_index) const{
@@ -141,12 +153,22 @@ double LSTMModel::getDrugFactor (WithinHost::CommonInfection *inf, double body_m
 
 void LSTMModel::decayDrugs (double body_mass) {
     // Update concentrations for each drug.
-    // TODO: previously we removed drugs with negligible concentration here. What now, just set concentration to 0?
+    // Drugs with negligible concentration are set to 0 but not removed: they
+    // hold PK parameters sampled for this human. isIdle() lets callers skip
+    // them instead.
     foreach( LSTMDrug& drug, m_drugs ){
         drug.updateConcentration(body_mass);
     }
 }
 
+bool LSTMModel::isIdle() const{
+    if( !medicateQueue.empty() ) return false;
+    foreach( const LSTMDrug& drug, m_drugs ){
+        if( !drug.isCleared() ) return false;
+    }
+    return true;
+}
+
 void LSTMModel::summarize(const Host::Human& human) const{
     const vector<size_t> &drugsInUse( LSTMDrugType::getDrugsInUse() );
     foreach( size_t index, drugsInUse ){
@@ -161,4 +183,14 @@ void LSTMModel::summarize(const Host::Human& human) const{
     }
 }
 
+void LSTMModel::memoryStats( util::MemoryStats& stats ) const{
+    stats.add( "drug lists", 1, m_drugs.capacity() * sizeof(void*)
+            + util::MemoryStats::bytes( m_drugPos ) );
+    foreach( const LSTMDrug& drug, m_drugs ){
+        stats.add( "drug", 1, drug.memoryBytes() );
+    }
+    stats.add( "pending medication", medicateQueue.size(), medicateQueue.size() *
+            (sizeof(MedicateData) + util::MemoryStats::LIST_NODE) );
+}
+
 } }
@@ -35,6 +35,9 @@ namespace Host{
 namespace WithinHost {
     class CommonInfection;
 }
+namespace util {
+    class MemoryStats;
+}
 namespace PkPd {
 using boost::ptr_vector;
 
@@ -135,9 +138,22 @@ public:
      * become negligible. */
     void decayDrugs (double body_mass);
     
+    /** True when all drugs in the body have been cleared (see
+     * LSTMDrug::isCleared()) and no medication is pending; in this state
+     * medicate() and decayDrugs() do nothing. */
+    bool isIdle() const;
+    
+    /** Remove all drugs and pending medications (keeping allocated memory
+     * where possible), as for a new human. */
+    void reset();
+    
     /** Make summaries of drug concentration data. */
     void summarize( const Host::Human& human ) const;
     
+    /** Add heap memory used: drug objects and pending medications (the
+     * LSTMModel object itself is part of its owner). */
+    void memoryStats( util::MemoryStats& stats ) const;
+    
 private:
     /** Medicate drugs to an individual, which act on infections the following
      * time steps, until rendered ineffective by decayDrugs().
@@ -163,6 +179,10 @@ private:
     typedef ptr_vector<LSTMDrug> DrugVec;
     /// Drugs with non-zero blood concentrations:
     DrugVec m_drugs;
+    /** For each drug type index, the position of its instance in m_drugs
+     * plus one, or zero if not present. Grown on demand; not checkpointed
+     * (rebuilt on load). */
+    vector<uint32_t> m_drugPos;
     
     /// All pending medications
     list<MedicateData> medicateQueue;
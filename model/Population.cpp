@@ -30,15 +30,21 @@
 #include "Clinical/CaseManagementCommon.h"
 #include "Transmission/TransmissionModel.h"
 
+#include "mon/management.h"
 #include "util/errors.h"
+#include "util/CommandLine.h"
 #include "util/random.h"
 #include "util/ModelOptions.h"
 #include "util/StreamValidator.h"
+#include "util/MemoryStats.h"
 #include <schema/scenario.h>
 
 #include <cmath>
+#include <algorithm>
 #include <boost/format.hpp>
 #include <boost/assign.hpp>
+#include <thread>
+#include <exception>
 
 namespace OM
 {
@@ -56,6 +62,12 @@ void Population::init( const Parameters& parameters, const scnXml::Scenario& sce
     AgeStructure::init( scenario.getDemography() );
 }
 
+void Population::staticChangeTimeStep( SimTime oldTS )
+{
+    AgeStructure::changeTimeStep();
+    Host::Human::staticChangeTimeStep( oldTS );
+}
+
 void Population::staticCheckpoint (istream& stream)
 {
     Host::NeonatalMortality::staticCheckpoint (stream);
@@ -75,7 +87,8 @@ void Population::staticCheckpoint (ostream& stream)
 // -----  non-static methods: creation/destruction, checkpointing  -----
 
 Population::Population(size_t populationSize)
-    : populationSize (populationSize), recentBirths(0)
+    : populationSize (populationSize), lastBirthDate(SimTime::never()),
+    birthsOnLastDate(0), recentBirths(0)
 {
     using Monitoring::Continuous;
     Continuous.registerCallback( "hosts", "\thosts", MakeDelegate( this, &Population::ctsHosts ) );
@@ -118,17 +131,22 @@ Population::~Population()
     for(Iter iter = population.begin(); iter != population.end(); ++iter) {
         iter->destroy();
     }
+    for(Iter iter = recycled.begin(); iter != recycled.end(); ++iter) {
+        iter->destroy();
+    }
 }
 
 void Population::checkpoint (istream& stream)
 {
     populationSize & stream;
+    lastBirthDate & stream;
+    birthsOnLastDate & stream;
     recentBirths & stream;
     
     for(size_t i = 0; i < populationSize && !stream.eof(); ++i) {
         // Note: calling this constructor of Host::Human is slightly wasteful, but avoids the need for another
         // ctor and leaves less opportunity for uninitialized memory.
-        population.push_back( new Host::Human (SimTime::zero()) );
+        population.push_back( new Host::Human (SimTime::zero(), static_cast<uint32_t>(0)) );
         population.back() & stream;
     }
     if (population.size() != populationSize)
@@ -138,12 +156,23 @@ void Population::checkpoint (istream& stream)
 void Population::checkpoint (ostream& stream)
 {
     populationSize & stream;
+    lastBirthDate & stream;
+    birthsOnLastDate & stream;
     recentBirths & stream;
     
     for(Iter iter = population.begin(); iter != population.end(); ++iter)
         (*iter) & stream;
 }
 
+void Population::memoryStats( util::MemoryStats& stats ) const{
+    stats.add( "population list", population.size(),
+               population.size() * util::MemoryStats::LIST_NODE );
+    stats.add( "recycled humans", recycled.size(),
+               recycled.size() * util::MemoryStats::LIST_NODE );
+    for(ConstIter iter = population.cbegin(); iter != population.cend(); ++iter)
+        iter->memoryStats( stats );
+}
+
 void Population::preMainSimInit ()
 {
     Host::InfectionIncidenceModel::initMainSimulation();
@@ -152,12 +181,20 @@ void Population::preMainSimInit ()
     recentBirths = 0;
 }
 
-void Population::createInitialHumans()
+void Population::changeTimeStep( SimTime oldTS )
+{
+    Host::NeonatalMortality::changeTimeStep( oldTS );
+    for(Iter iter = population.begin(); iter != population.end(); ++iter)
+        iter->changeTimeStep( oldTS );
+}
+
+void Population::createInitialHumans( SimTime firstVecInitTS )
 {
     /* We create a whole population here, regardless of whether humans can
     survive until start of vector init (vector model needs a whole population
     structure in any case). However, we don't update humans known not to survive
-    until vector init, which saves computation and memory (no infections). */
+    until vector init, which saves computation and memory (no infections).
+    These are made placeholders, sharing their sub-models, to save more memory. */
     
     int cumulativePop = 0;
     for(size_t iage_prev = AgeStructure::getMaxTStepsPerLife(), iage = iage_prev - 1;
@@ -165,7 +202,11 @@ void Population::createInitialHumans()
     {
         int targetPop = AgeStructure::targetCumPop( iage, populationSize );
         while (cumulativePop < targetPop) {
-            newHuman( SimTime::zero() - SimTime::fromTS(iage) );
+            SimTime dob = SimTime::zero() - SimTime::fromTS(iage);
+            newHuman( dob );
+            // same condition as in update1():
+            if( dob + sim::maxHumanAge() < firstVecInitTS )
+                population.back().makePlaceholder();
             ++cumulativePop;
         }
     }
@@ -180,10 +221,35 @@ void Population::createInitialHumans()
 
 void Population::newHuman( SimTime dob ){
     util::streamValidate( dob.raw() );
-    population.push_back( new Host::Human (dob) );
+    if( dob != lastBirthDate ){
+        lastBirthDate = dob;
+        birthsOnLastDate = 0;
+    }
+    uint32_t birthIndex = birthsOnLastDate++;
+    util::random::SubStream stream( util::random::HOST_INIT,
+            Host::Human::makeID( dob, birthIndex ) );
+    if( recycled.empty() ){
+        population.push_back( new Host::Human (dob, birthIndex) );
+    }else{
+        // move the list node (no allocation), then reinitialise
+        population.transfer( population.end(), recycled.begin(), recycled );
+        population.back().reset( dob, birthIndex );
+    }
     ++recentBirths;
 }
 
+Population::Iter Population::removeHuman( Iter iter ){
+    if( iter->isPlaceholder() ){
+        iter->destroy();
+        return population.erase (iter);
+    }
+    iter->retire();
+    Iter next = iter;
+    ++next;
+    recycled.transfer( recycled.end(), iter, population );
+    return next;
+}
+
 void Population::update1( SimTime firstVecInitTS ){
     // This should only use humans being updated: otherwise too small a proportion
     // will be infected. However, we don't have another number to use instead.
@@ -197,6 +263,17 @@ void Population::update1( SimTime firstVecInitTS ){
     //int targetPop = (int) (populationSize * exp( AgeStructure::rho * sim::ts1().inSteps() ));
     int targetPop = populationSize;
     int cumPop = 0;
+    
+    // Sums for kappa are collected in this pass, after each human's update;
+    // the population is in the same order as when summed separately.
+    Transmission::TransmissionModel::KappaSums& kappaSums =
+        sim::transmission().fusedKappaSums();
+    kappaSums.reset();
+    // Likewise statistics for neonatal mortality and continuous outputs
+    // (the latter only when output will be reported at the end of the step).
+    if( !hostStatsData.initialised ) initHostStats();
+    hostStatsData.reset( Monitoring::Continuous.isReportTime( sim::ts1(),
+            sim::intervNow() + SimTime::oneTS() ) );
 
     // Update each human in turn
     //std::cout<<" time " <<t<<std::endl;
@@ -209,10 +286,12 @@ void Population::update1( SimTime firstVecInitTS ){
         // is the time step they die at (some code still runs on this step).
         SimTime lastPossibleTS = iter->getDateOfBirth() + sim::maxHumanAge();   // this is last time of possible update
         bool updateHuman = lastPossibleTS >= firstVecInitTS;
+        // Only has an effect after loading a checkpoint (placeholders are
+        // checkpointed like other humans):
+        if( !updateHuman ) iter->makePlaceholder();
         bool isDead = iter->update(updateHuman);
         if( isDead ){
-            iter->destroy();
-            iter = population.erase (iter);
+            iter = removeHuman( iter );
             continue;
         }
         
@@ -225,11 +304,12 @@ void Population::update1( SimTime firstVecInitTS ){
         // Also see targetPop = ... comment above
         if( cumPop > AgeStructure::targetCumPop(iter->age(sim::ts1()).inSteps(), targetPop) ){
             --cumPop;
-            iter->destroy();
-            iter = population.erase (iter);
+            iter = removeHuman( iter );
             continue;
         }
         //END Population size & age structure
+        kappaSums.add( *iter );
+        hostStatsData.add( *iter, iter->age(sim::ts1()) );
         ++iter;
     } // end of per-human updates
 
@@ -237,9 +317,72 @@ void Population::update1( SimTime firstVecInitTS ){
     while (cumPop < targetPop) {
         // humans born at end of this time step = beginning of next, hence ts1
         newHuman( sim::ts1() );
+        kappaSums.add( population.back() );
+        hostStatsData.add( population.back(), SimTime::zero() );
         //++nCounter;
         ++cumPop;
     }
+    hostStatsData.time = sim::ts1();
+}
+
+
+// -----  host statistics  -----
+
+void Population::HostStats::reset( bool cts ){
+    time = SimTime::never();
+    nMothers = nPatentMothers = 0;
+    haveCts = cts;
+    if( !haveCts ) return;
+    nByAgeGroup.assign( ageGroups.size() + 1, 0 );
+    nPatent = 0;
+    sum_h = sum_Y = 0.0;
+    list_Y.clear();
+}
+
+void Population::HostStats::add( const Host::Human& human, SimTime age ){
+    if( countMothers )
+        Host::NeonatalMortality::countMother( human, age, nMothers, nPatentMothers );
+    if( !haveCts ) return;
+    if( wantDemography ){
+        size_t i = upper_bound( ageGroups.begin(), ageGroups.end(), age.inYears() )
+            - ageGroups.begin();
+        ++nByAgeGroup[i];
+    }
+    const WithinHost::WHInterface& whm = human.getWithinHostModel();
+    if( wantPatent && whm.diagnosticResult(WithinHost::diagnostics::monitoringDiagnostic()) )
+        ++nPatent;
+    if( wantImmunity_h ) sum_h += whm.getCumulative_h();
+    if( wantImmunity_Y ) sum_Y += whm.getCumulative_Y();
+    if( wantMedianY ) list_Y.push_back( whm.getCumulative_Y() );
+}
+
+void Population::initHostStats (){
+    using Monitoring::Continuous;
+    HostStats& d = hostStatsData;
+    d.countMothers = Host::NeonatalMortality::canCountMothersInUpdate();
+    d.wantDemography = Continuous.isEnabled( "host demography" );
+    d.ageGroups = ctsDemogAgeGroups;
+    // stochastic diagnostics are left to ctsSweep() to keep the order of random draws
+    d.wantPatent = Continuous.isEnabled( "patent hosts" ) &&
+        WithinHost::diagnostics::monitoringDiagnostic().isDeterministic();
+    d.wantImmunity_h = Continuous.isEnabled( "immunity h" );
+    d.wantImmunity_Y = Continuous.isEnabled( "immunity Y" );
+    d.wantMedianY = Continuous.isEnabled( "median immunity Y" );
+    if( d.wantMedianY ) d.list_Y.reserve( populationSize );
+    d.initialised = true;
+}
+
+Population::HostStats& Population::ctsHostStats (){
+    HostStats& d = hostStatsData;
+    if( d.time == sim::now() && d.haveCts ) return d;
+    
+    if( !d.initialised ) initHostStats();
+    d.reset( true );
+    for(Iter iter = population.begin(); iter != population.end(); ++iter) {
+        d.add( *iter, iter->age(sim::now()) );
+    }
+    d.time = sim::now();
+    return d;
 }
 
 
@@ -250,13 +393,10 @@ void Population::ctsHosts (ostream& stream){
     stream << '\t' << population.size();
 }
 void Population::ctsHostDemography (ostream& stream){
-    Population::ConstReverseIter it = population.crbegin();
+    const HostStats& d = ctsHostStats();
     int cumCount = 0;
-    foreach( double ubound, ctsDemogAgeGroups ){
-        while( it != population.crend() && it->age(sim::now()).inYears() < ubound ){
-            ++cumCount;
-            ++it;
-        }
+    for( size_t i = 0; i < d.ageGroups.size(); ++i ){
+        cumCount += d.nByAgeGroup[i];
         stream << '\t' << cumCount;
     }
 }
@@ -264,79 +404,82 @@ void Population::ctsRecentBirths (ostream& stream){
     stream << '\t' << recentBirths;
     recentBirths = 0;
 }
-void Population::ctsPatentHosts (ostream& stream){
-    int patent = 0;
+const Population::CtsSweep& Population::ctsSweep (){
+    CtsSweep& d = ctsSweepData;
+    if( d.time == sim::now() ) return d;
+    d.time = sim::now();
+    
+    if( !d.initialised ){
+        using Monitoring::Continuous;
+        d.wantPatent = Continuous.isEnabled( "patent hosts" ) &&
+            !WithinHost::diagnostics::monitoringDiagnostic().isDeterministic();
+        d.wantAgeAvail = Continuous.isEnabled( "human age availability" );
+        d.wantInterv = Continuous.isEnabled( "ITN coverage" ) ||
+            Continuous.isEnabled( "IRS coverage" ) ||
+            Continuous.isEnabled( "GVI coverage" );
+        d.initialised = true;
+    }
+    
+    d.nPatent = d.nAvail = d.nITN = d.nIRS = d.nGVI = 0;
+    d.sumAvail = 0.0;
     for(Iter iter = population.begin(); iter != population.end(); ++iter) {
-        if( iter->getWithinHostModel().diagnosticResult(WithinHost::diagnostics::monitoringDiagnostic()) )
-            ++patent;
+        const WithinHost::WHInterface& whm = iter->getWithinHostModel();
+        if( d.wantPatent && whm.diagnosticResult(WithinHost::diagnostics::monitoringDiagnostic()) )
+            ++d.nPatent;
+        if( d.wantAgeAvail && !iter->perHostTransmission.isOutsideTransmission() ){
+            ++d.nAvail;
+            d.sumAvail += iter->perHostTransmission.relativeAvailabilityAge(iter->age(sim::now()).inYears());
+        }
+        if( d.wantInterv ){
+            d.nITN += iter->perHostTransmission.hasActiveInterv( interventions::Component::ITN );
+            d.nIRS += iter->perHostTransmission.hasActiveInterv( interventions::Component::IRS );
+            d.nGVI += iter->perHostTransmission.hasActiveInterv( interventions::Component::GVI );
+        }
     }
-    stream << '\t' << patent;
+    return d;
+}
+void Population::ctsPatentHosts (ostream& stream){
+    if( WithinHost::diagnostics::monitoringDiagnostic().isDeterministic() )
+        stream << '\t' << ctsHostStats().nPatent;
+    else
+        stream << '\t' << ctsSweep().nPatent;
 }
 void Population::ctsImmunityh (ostream& stream){
-    double x = 0.0;
-    for(Iter iter = population.begin(); iter != population.end(); ++iter) {
-        x += iter->getWithinHostModel().getCumulative_h();
-    }
+    double x = ctsHostStats().sum_h;
     x /= populationSize;
     stream << '\t' << x;
 }
 void Population::ctsImmunityY (ostream& stream){
-    double x = 0.0;
-    for(Iter iter = population.begin(); iter != population.end(); ++iter) {
-        x += iter->getWithinHostModel().getCumulative_Y();
-    }
+    double x = ctsHostStats().sum_Y;
     x /= populationSize;
     stream << '\t' << x;
 }
 void Population::ctsMedianImmunityY (ostream& stream){
-    vector<double> list;
-    list.reserve( populationSize );
-    for(Iter iter = population.begin(); iter != population.end(); ++iter) {
-        list.push_back( iter->getWithinHostModel().getCumulative_Y() );
-    }
-    sort( list.begin(), list.end() );
-    double x;
-    if( mod_nn(populationSize, 2) == 0 ){
-        size_t i = populationSize / 2;
-        x = (list[i-1]+list[i])/2.0;
-    }else{
-        x = list[populationSize / 2];
+    // Selection instead of a full sort; this reorders the list.
+    vector<double>& list = ctsHostStats().list_Y;
+    size_t i = list.size() / 2;
+    nth_element( list.begin(), list.begin() + i, list.end() );
+    double x = list[i];
+    if( list.size() % 2 == 0 ){
+        // the lower middle value is the largest of those before i
+        x = (*max_element( list.begin(), list.begin() + i ) + x) / 2.0;
     }
     stream << '\t' << x;
 }
 void Population::ctsMeanAgeAvailEffect (ostream& stream){
-    int nHumans = 0;
-    double avail = 0.0;
-    for(Iter iter = population.begin(); iter != population.end(); ++iter) {
-        if( !iter->perHostTransmission.isOutsideTransmission() ){
-            ++nHumans;
-            avail += iter->perHostTransmission.relativeAvailabilityAge(iter->age(sim::now()).inYears());
-        }
-    }
-    stream << '\t' << avail/nHumans;
+    const CtsSweep& d = ctsSweep();
+    stream << '\t' << d.sumAvail/d.nAvail;
 }
 void Population::ctsITNCoverage (ostream& stream){
-    int nActive = 0;
-    for(Iter iter = population.begin(); iter != population.end(); ++iter) {
-        nActive += iter->perHostTransmission.hasActiveInterv( interventions::Component::ITN );
-    }
-    double coverage = static_cast<double>(nActive) / populationSize;
+    double coverage = static_cast<double>(ctsSweep().nITN) / populationSize;
     stream << '\t' << coverage;
 }
 void Population::ctsIRSCoverage (ostream& stream){
-    int nActive = 0;
-    for(Iter iter = population.begin(); iter != population.end(); ++iter) {
-        nActive += iter->perHostTransmission.hasActiveInterv( interventions::Component::IRS );
-    }
-    double coverage = static_cast<double>(nActive) / populationSize;
+    double coverage = static_cast<double>(ctsSweep().nIRS) / populationSize;
     stream << '\t' << coverage;
 }
 void Population::ctsGVICoverage (ostream& stream){
-    int nActive = 0;
-    for(Iter iter = population.begin(); iter != population.end(); ++iter) {
-        nActive += iter->perHostTransmission.hasActiveInterv( interventions::Component::GVI );
-    }
-    double coverage = static_cast<double>(nActive) / populationSize;
+    double coverage = static_cast<double>(ctsSweep().nGVI) / populationSize;
     stream << '\t' << coverage;
 }
 // void Population::ctsNetHoleIndex (ostream& stream){
@@ -351,13 +494,77 @@ void Population::ctsGVICoverage (ostream& stream){
 //     stream << '\t' << meanVar/nNets;
 // }
 
+// Survey collection is not split into chunks smaller than this
+const size_t minHumansPerSurveyThread = 100;
+
 void Population::newSurvey ()
 {
+    size_t nThreads = min( util::CommandLine::getSurveyThreads(),
+                           population.size() / minHumansPerSurveyThread );
+    // A stochastic monitoring diagnostic samples random numbers, which must
+    // happen in population order.
+    if( nThreads > 1 && WithinHost::diagnostics::monitoringDiagnostic().isDeterministic() ){
+        summarizeParallel( nThreads );
+        return;
+    }
     for(Iter iter = population.begin(); iter != population.end(); ++iter) {
         iter->summarize();
     }
 }
 
+void Population::summarizeParallel( size_t nThreads ){
+    // Split the population into contiguous chunks, one per thread
+    const size_t chunkSize = (population.size() + nThreads - 1) / nThreads;
+    vector<Iter> bounds;
+    size_t i = 0;
+    for( Iter iter = population.begin(); iter != population.end(); ++iter, ++i ){
+        if( i % chunkSize == 0 ) bounds.push_back( iter );
+    }
+    bounds.push_back( population.end() );
+    const size_t nChunks = bounds.size() - 1;
+    
+    // Reports of each chunk, and for each human the end of its reports in
+    // the buffer and whether Human::endSummary() is needed
+    vector<mon::ReportBuffer> buffers( nChunks );
+    vector<vector<pair<size_t, bool> > > summaries( nChunks );
+    vector<std::exception_ptr> errors( nChunks );
+    auto collect = [&]( size_t c ){
+        mon::setReportBuffer( &buffers[c] );
+        try{
+            for( Iter iter = bounds[c]; iter != bounds[c+1]; ++iter ){
+                bool end = iter->summarizeReports();
+                summaries[c].push_back( make_pair( buffers[c].size(), end ) );
+            }
+        }catch( ... ){
+            errors[c] = std::current_exception();
+        }
+        mon::setReportBuffer( 0 );
+    };
+    vector<std::thread> threads;
+    for( size_t c = 1; c < nChunks; ++c ){
+        threads.push_back( std::thread( collect, c ) );
+    }
+    collect( 0 );
+    for( size_t c = 0; c < threads.size(); ++c ){
+        threads[c].join();
+    }
+    for( size_t c = 0; c < nChunks; ++c ){
+        if( errors[c] ) std::rethrow_exception( errors[c] );
+    }
+    
+    // Store reports and apply side effects in population order, as in the
+    // serial case, so that results do not depend on the number of threads.
+    for( size_t c = 0; c < nChunks; ++c ){
+        Iter iter = bounds[c];
+        size_t begin = 0;
+        for( size_t j = 0; j < summaries[c].size(); ++j, ++iter ){
+            buffers[c].replay( begin, summaries[c][j].first );
+            begin = summaries[c][j].first;
+            if( summaries[c][j].second ) iter->endSummary();
+        }
+    }
+}
+
 void Population::flushReports (){
     for(Iter iter = population.begin(); iter != population.end(); ++iter) {
         iter->flushReports();
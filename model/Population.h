@@ -45,7 +45,12 @@ public:
     /// Checkpointing for static data members
     static void staticCheckpoint (istream& stream);
     static void staticCheckpoint (ostream& stream); ///< ditto
-
+    
+    /** Adjust static parameters of sub-models after the time-step length
+     * changed from oldTS to SimTime::oneTS() (model option COARSE_WARMUP).
+     * Call before changeTimeStep(), or before reading a checkpoint written
+     * with the new time step (in which case there are no humans yet). */
+    static void staticChangeTimeStep( SimTime oldTS );
 
     Population( size_t populationSize );
     //! Clears human collection.
@@ -54,12 +59,22 @@ public:
     void checkpoint (istream& stream);
     void checkpoint (ostream& stream);
     
-    /** Creates the initial population of Humans according to cumAgeProp. */
-    void createInitialHumans();
+    /** Creates the initial population of Humans according to cumAgeProp.
+     * 
+     * @param firstVecInitTS As for update1(); humans who will not survive
+     *  until this time are created as placeholders (see
+     *  Host::Human::makePlaceholder()). */
+    void createInitialHumans( SimTime firstVecInitTS );
     
     /** Initialisation run between initial one-lifespan run of simulation and
      * actual simulation. */
     void preMainSimInit ();
+    
+    /** Convert state stored per time step (of humans and static sub-model
+     * state which is checkpointed) after the time-step length changed from
+     * oldTS to SimTime::oneTS(). Call after staticChangeTimeStep(), between
+     * updates. */
+    void changeTimeStep( SimTime oldTS );
 
     //! Updates all individuals in the list for one time-step
     /*!  Also updates the population-level measures such as infectiousness, and
@@ -73,6 +88,9 @@ public:
     /// Flush anything pending report. Should only be called just before destruction.
     void flushReports();
     
+    /// Add memory used by the population (including all humans) to stats
+    void memoryStats( util::MemoryStats& stats ) const;
+    
     /// Type of population list. Store pointers to humans only to avoid copy
     /// operations which (AFAIAA) are otherwise required in C++98.
     // TODO: use C++11 move semantics
@@ -106,6 +124,41 @@ public:
         return populationSize;
     }
     //@}
+    
+    /** Statistics collected in update1() after each human's update (like the
+     * transmission model's kappa sums), so that consumers need not sweep the
+     * population again. Ages are taken at the end of the step in which they
+     * were collected. */
+    struct HostStats {
+        HostStats() : time(SimTime::never()), initialised(false),
+            countMothers(false), haveCts(false) {}
+        /// Zero counts; cts: whether to collect continuous output statistics
+        void reset( bool cts );
+        /// Add a human of the given age
+        void add( const Host::Human& human, SimTime age );
+        
+        /// Time these were collected for (end of step), or never
+        SimTime time;
+        bool initialised;       // whether the flags below have been set
+        /// Whether potential mothers are counted (see Host::NeonatalMortality)
+        bool countMothers;
+        int nMothers, nPatentMothers;
+        /// Whether the continuous output statistics below were collected
+        bool haveCts;
+        bool wantDemography, wantPatent, wantImmunity_h, wantImmunity_Y,
+            wantMedianY;
+        /// Upper bounds of demography age groups (years)
+        vector<double> ageGroups;
+        /// Number of humans in each age group (last: older than all bounds)
+        vector<int> nByAgeGroup;
+        int nPatent;    // only if the monitoring diagnostic is deterministic
+        double sum_h, sum_Y;
+        vector<double> list_Y;  // unordered
+    };
+    /** Statistics from the last update; check HostStats::time before use. */
+    inline const HostStats& hostStats() const {
+        return hostStatsData;
+    }
 
 private:
     /// Creates initializes and add to the population list a new uninfected human
@@ -113,6 +166,36 @@ private:
     /// @param dob date of birth (usually current time)
     void newHuman( SimTime dob );
     
+    /** Remove a dead (or out-migrating) human from the population, keeping
+     * the object for reuse by newHuman() unless it is a placeholder.
+     * Returns the iterator following iter. */
+    Iter removeHuman( Iter iter );
+    
+    /** Summarize all humans using nThreads threads (see newSurvey()). */
+    void summarizeParallel( size_t nThreads );
+    
+    /** Statistics gathered for several continuous outputs in a single pass
+     * over the population. */
+    struct CtsSweep {
+        CtsSweep() : time(SimTime::never()), initialised(false) {}
+        SimTime time;   // time of last sweep
+        bool initialised;       // whether the flags below have been set
+        bool wantPatent, wantAgeAvail, wantInterv;
+        int nPatent, nAvail, nITN, nIRS, nGVI;
+        double sumAvail;
+    };
+    /** Return statistics for this time step, sweeping the population if not
+     * already done. Only statistics for enabled outputs are collected, and
+     * not those available from ctsHostStats(). */
+    const CtsSweep& ctsSweep ();
+    
+    /// Set HostStats flags; needs continuous output to be initialised
+    void initHostStats ();
+    /** Return host statistics for continuous outputs at this time, sweeping
+     * the population if they were not collected during the last update
+     * (e.g. just after loading a checkpoint). */
+    HostStats& ctsHostStats ();
+    
     /// Delegate to print the number of hosts
     void ctsHosts (ostream& stream);
     /// Delegate to print cumulative numbers of hosts under various age limits
@@ -139,19 +222,33 @@ private:
     //! Size of the human population
     size_t populationSize;
     
+    /// Date of birth of the last human created and the number of humans
+    /// created with this date (see Host::Human::getID())
+    SimTime lastBirthDate;
+    uint32_t birthsOnLastDate;
+    
     ///@brief Variables for continuous reporting
     //@{
     vector<double> ctsDemogAgeGroups;
     
     /// Births since last continuous output
     int recentBirths;
+    
+    CtsSweep ctsSweepData;
     //@}
     
+    HostStats hostStatsData;
+    
     /** The simulated human population
      *
      * The list of all humans, ordered from oldest to youngest. */
     HumanPop population;
     
+    /** Dead humans kept for reuse by newHuman(), to save reallocating their
+     * sub-models. Births balance deaths each step, so this stays small. Not
+     * checkpointed. */
+    HumanPop recycled;
+    
     friend class AnophelesModelSuite;
 };
 
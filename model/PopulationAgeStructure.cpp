@@ -21,12 +21,14 @@
 #include "PopulationAgeStructure.h"
 #include "Global.h"
 #include "util/errors.h"
+#include "util/InitCache.h"
 #include "schema/demography.h"
 
 #include <cmath>
 #include <gsl_vector_double.h>
 #include <gsl/gsl_multimin.h>
 #include <fstream>
+#include <sstream>
 
 namespace OM {
     using namespace OM::util;
@@ -48,8 +50,39 @@ void AgeStructure::init( const scnXml::Demography& demography ){
     // this number of cells are needed:
     cumAgeProp.resize( sim::maxHumanAge().inSteps() + 1 );
     
+    // The fit depends only on the demography inputs and time-step length, so
+    // may be reused from the init cache (see --init-cache).
+    ostringstream key;
+    key.precision( 17 );
+    key << "AgeStructure " << SimTime::oneTS().inDays() << ' ' << cumAgeProp.size();
+    if( demography.getGrowthRate().present() )
+        key << " r" << demography.getGrowthRate().get();
+    foreach( const scnXml::DemogGroupBounds& group, demography.getAgeGroup().getGroup() ){
+        key << ' ' << group.getUpperbound() << ':' << group.getPoppercent();
+    }
+    
+    vector<double> cached;
+    if( InitCache::get( key.str(), cached ) && cached.size() == cumAgeProp.size() + 5 ){
+        mu0 = cached[0];        mu1 = cached[1];
+        alpha0 = cached[2];     alpha1 = cached[3];
+        rho = cached[4];
+        copy( cached.begin() + 5, cached.end(), cumAgeProp.begin() );
+        return;
+    }
+    
     estimateRemovalRates( demography );
     calcCumAgeProp();
+    
+    if( InitCache::enabled() ){
+        cached.assign( { mu0, mu1, alpha0, alpha1, rho } );
+        cached.insert( cached.end(), cumAgeProp.begin(), cumAgeProp.end() );
+        InitCache::put( key.str(), cached );
+    }
+}
+
+void AgeStructure::changeTimeStep(){
+    cumAgeProp.resize( sim::maxHumanAge().inSteps() + 1 );
+    calcCumAgeProp();
 }
 
 int AgeStructure::targetCumPop( size_t ageTSteps, int targetPop ){
@@ -34,6 +34,10 @@ namespace OM
         /** Set up cumAgeProp from XML data. */
         static void init( const scnXml::Demography& demography );
         
+        /** Recalculate cumAgeProp after a change of time-step length (the
+        * fitted demography parameters are reused). */
+        static void changeTimeStep();
+        
         /** Return maximum individual lifetime in intervals that AgeStructure can handle. */
         static inline size_t getMaxTStepsPerLife(){
             return cumAgeProp.size();
@@ -19,12 +19,14 @@
  */
 
 #include "PopulationStats.h"
+#include "util/CommandLine.h"
 
 namespace OM {
     boost::int64_t PopulationStats::totalInfections =0;
     boost::int64_t PopulationStats::allowedInfections =0;
     boost::int64_t PopulationStats::humanUpdateCalls =0;
     boost::int64_t PopulationStats::humanUpdates =0;
+    boost::int64_t PopulationStats::quiescentWHUpdates =0;
     
     void PopulationStats::print() {
 #	ifdef WITHOUT_BOINC
@@ -43,9 +45,22 @@ namespace OM {
 	    <<"\t("<<x<<"% skipped)"
 	    <<endl
 	;
+	
+	if( quiescentWHUpdates > 0 ){
+	    x = 100.0 * quiescentWHUpdates / humanUpdates;
+	    cerr
+		<< "Quiescent within-host updates: "
+		<<quiescentWHUpdates<<"/"<<humanUpdates
+		<<"\t("<<x<<"% elided)"
+		<<endl
+	    ;
+	}
 #	else	// use reduced-output mode
 	cerr<<"T/A: "<<totalInfections<<"/"<<allowedInfections<<endl;
 #	endif
+	if( util::CommandLine::option( util::CommandLine::PRINT_PERF_STATS ) ){
+	    cerr<<"perf\thuman_updates\t"<<humanUpdates<<endl;
+	}
     }
     
     void PopulationStats::staticCheckpoint (istream& stream){
@@ -53,12 +68,14 @@ namespace OM {
 	allowedInfections & stream;
 	humanUpdateCalls & stream;
 	humanUpdates & stream;
+	quiescentWHUpdates & stream;
     }
     void PopulationStats::staticCheckpoint (ostream& stream){
 	totalInfections & stream;
 	allowedInfections & stream;
 	humanUpdateCalls & stream;
 	humanUpdates & stream;
+	quiescentWHUpdates & stream;
     }
     
 }
@@ -41,6 +41,9 @@ namespace OM {
 	
 	static boost::int64_t humanUpdateCalls;
 	static boost::int64_t humanUpdates;
+	/// Within-host updates which took the quiescent fast path (no
+	/// infections and drugs cleared; see CommonWithinHost::update)
+	static boost::int64_t quiescentWHUpdates;
     };
 }
 
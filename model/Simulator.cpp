@@ -30,6 +30,8 @@
 #include "Population.h"
 #include "WithinHost/Diagnostic.h"
 #include "WithinHost/Genotypes.h"
+#include "PkPd/Drug/LSTMDrugType.h"
+#include "PkPd/LSTMTreatments.h"
 #include "mon/management.h"
 #include "util/BoincWrapper.h"
 #include "util/timer.h"
@@ -38,9 +40,11 @@
 #include "util/errors.h"
 #include "util/random.h"
 #include "util/StreamValidator.h"
+#include "util/MemoryStats.h"
 #include "schema/scenario.h"
 
 #include <fstream>
+#include <chrono>
 #include <gzstream/gzstream.h>
 
 
@@ -74,12 +78,25 @@ enum Phase {
     END_SIM         // should have largest value of all enumerations
 };
 
+/// Write memory use per subsystem to stderr (if --memory-stats was used)
+void printMemoryStats(){
+    if( !util::MemoryStats::enabled() ) return;
+    util::MemoryStats stats;
+    sim::humanPop().memoryStats( stats );
+    sim::transmission().memoryStats( stats );
+    mon::memoryStats( stats );
+    stats.write( cerr );
+}
+
 
 // ———  Set-up & tear-down  ———
 
 Simulator::Simulator( util::Checksum ck, const scnXml::Scenario& scenario ) :
     simPeriodEnd(SimTime::zero()),
     totalSimDuration(SimTime::zero()),
+    humanWarmupLength(SimTime::zero()),
+    testCheckpointTime(SimTime::never()),
+    testCheckpointDieTime(SimTime::never()),
     phase(STARTING_PHASE),
     workUnitIdentifier(0),
     cksum(ck)
@@ -95,6 +112,8 @@ Simulator::Simulator( util::Checksum ck, const scnXml::Scenario& scenario ) :
     
     util::random::seed( model.getParameters().getIseed() );
     util::ModelOptions::init( model.getModelOptions() );
+    util::random::enableSubStreams(
+            util::ModelOptions::option( util::COMMON_RANDOM_NUMBERS ) );
     
     // 2) elements depending on only elements initialised in (1):
     
@@ -137,16 +156,64 @@ Simulator::Simulator( util::Checksum ck, const scnXml::Scenario& scenario ) :
     startedFromCheckpoint = checkpointFile.is_open();
 }
 
+void Simulator::clearStatic(){
+    // Data which init functions replace rather than add to is not listed.
+    sim::p_humanPop.reset();
+    sim::p_transmission.reset();
+    interventions::InterventionManager::clear();
+    Continuous.clear();
+    mon::clear();
+    PkPd::LSTMTreatments::clear();
+    PkPd::LSTMDrugType::clear();
+    WithinHost::diagnostics::clear();
+}
+
 
 // ———  run simulations  ———
 
+void Simulator::changeTimeStep( SimTime newTS ){
+    const SimTime oldTS = SimTime::oneTS();
+    if( newTS == oldTS ) return;
+    sim::setOneTS( newTS );
+    Population::staticChangeTimeStep( oldTS );
+    sim::humanPop().changeTimeStep( oldTS );
+    sim::transmission().changeTimeStep( oldTS );
+}
+
 void Simulator::start(const scnXml::Monitoring& monitoring){
+    prepare( monitoring, isCheckpoint() );
+    if (isCheckpoint()) readCheckpoint();
+    // Set to either a checkpointing time step or min int value. We only need to
+    // set once, since we exit after a checkpoint triggered this way.
+    testCheckpointTime = util::CommandLine::getNextCheckpointTime( sim::now() );
+    testCheckpointDieTime = testCheckpointTime;        // kill program at same time
+    
+    run( SimTime::future() );
+    
+    // Open a critical section; should prevent app kill while/after writing
+    // output.txt, which we don't currently handle well.
+    // Note: we don't end this critical section; we simply exit.
+    util::BoincWrapper::beginCriticalSection();
+    
+    PopulationStats::print();
+    printMemoryStats();
+    
+    sim::humanPop().flushReports();        // ensure all Human instances report past events
+    mon::writeSurveyData();
+    Continuous.finalise();
+    
+# ifdef OM_STREAM_VALIDATOR
+    util::StreamValidator.saveStream();
+# endif
+}
+
+void Simulator::prepare( const scnXml::Monitoring& monitoring, bool resume ){
     sim::time0 = SimTime::zero();
     sim::time1 = SimTime::zero();
     
     // Make sure warmup period is at least as long as a human lifespan, as the
     // length required by vector warmup, and is a whole number of years.
-    SimTime humanWarmupLength = sim::maxHumanAge();
+    humanWarmupLength = sim::maxHumanAge();
     if( humanWarmupLength < sim::transmission().minPreinitDuration() ){
         cerr << "Warning: human life-span (" << humanWarmupLength.inYears();
         cerr << ") shorter than length of warm-up requested by" << endl;
@@ -164,23 +231,25 @@ void Simulator::start(const scnXml::Monitoring& monitoring){
         + mon::finalSurveyTime() + SimTime::oneTS();
     assert( totalSimDuration + SimTime::never() < SimTime::zero() );
     
-    if (isCheckpoint()) {
-        Continuous.init( monitoring, true );
-        readCheckpoint();
-    } else {
-        Continuous.init( monitoring, false );
-        sim::humanPop().createInitialHumans();
+    Continuous.init( monitoring, resume );
+    if( !resume ){
+        if( util::ModelOptions::option( util::COARSE_WARMUP ) ){
+            // The human warm-up uses 5-day steps; see TRANSMISSION_INIT in run()
+            changeTimeStep( SimTime::fromDays(5) );
+        }
+        sim::humanPop().createInitialHumans( humanWarmupLength );
         sim::transmission().init2();
     }
-    // Set to either a checkpointing time step or min int value. We only need to
-    // set once, since we exit after a checkpoint triggered this way.
-    SimTime testCheckpointTime = util::CommandLine::getNextCheckpointTime( sim::now() );
-    SimTime testCheckpointDieTime = testCheckpointTime;        // kill program at same time
+}
+
+bool Simulator::run( SimTime endTime ){
+    if( phase == END_SIM ) return true;
     
     // phase loop
     while (true){
         // loop for steps within a phase
         while (sim::now() < simPeriodEnd){
+            if( sim::intervNow() >= endTime ) return false;
             util::BoincWrapper::reportProgress(sim::now().raw(), totalSimDuration.raw());
             if( util::BoincWrapper::timeToCheckpoint() || testCheckpointTime == sim::now() ){
                 writeCheckpoint();
@@ -197,6 +266,7 @@ void Simulator::start(const scnXml::Monitoring& monitoring){
                 sim::humanPop().newSurvey();
                 sim::transmission().summarize();
                 mon::concludeSurvey();
+                printMemoryStats();
             }
             
             // Deploy interventions, at time sim::now().
@@ -208,13 +278,19 @@ void Simulator::start(const scnXml::Monitoring& monitoring){
             
             // This should be called before humans contract new infections in the simulation step.
             // This needs the whole population (it is an approximation before all humans are updated).
-            sim::transmission().vectorUpdate ();
+            {
+                util::random::SubStream stream( util::random::TRANSMISSION, 0, 0 );
+                sim::transmission().vectorUpdate ();
+            }
             
             sim::humanPop().update1(humanWarmupLength);
             
             // Doesn't matter whether non-updated humans are included (value isn't used
             // before all humans are updated).
-            sim::transmission().update();
+            {
+                util::random::SubStream stream( util::random::TRANSMISSION, 0, 1 );
+                sim::transmission().update();
+            }
             
             sim::end_update();
         }
@@ -225,6 +301,11 @@ void Simulator::start(const scnXml::Monitoring& monitoring){
             simPeriodEnd = humanWarmupLength;
             
         } else if (phase == TRANSMISSION_INIT) {
+            // End of a coarse warm-up: switch to the scenario's time step.
+            // humanWarmupLength is a whole number of years, thus a multiple
+            // of both step lengths.
+            changeTimeStep( sim::scenarioTS() );
+            
             // Start or continuation of transmission init cycle (after one life span)
             SimTime iterate = sim::transmission().initIterate();
             if( iterate > SimTime::zero() ){
@@ -246,12 +327,15 @@ void Simulator::start(const scnXml::Monitoring& monitoring){
             
         } else if (phase == END_SIM) {
             cerr << "sim end" << endl;
-            break;
+            return true;
         }
         
         if (util::CommandLine::option (util::CommandLine::TEST_CHECKPOINTING)){
             // First of middle of next phase, or current value (from command line) triggers a checkpoint.
             SimTime phase_mid = sim::now() + (simPeriodEnd - sim::now()) * 0.5;
+            // round down to a whole step (steps may be longer than the
+            // scenario's during the warm-up; see COARSE_WARMUP)
+            phase_mid = SimTime::fromTS( phase_mid.inSteps() );
             // Don't checkpoint 0-length phases or do mid-phase checkpointing
             // when timed checkpoints were specified, and don't checkpoint
             // ONE_LIFE_SPAN phase if already past time humanWarmupLength:
@@ -267,21 +351,6 @@ void Simulator::start(const scnXml::Monitoring& monitoring){
             }
         }
     }
-    
-    // Open a critical section; should prevent app kill while/after writing
-    // output.txt, which we don't currently handle well.
-    // Note: we don't end this critical section; we simply exit.
-    util::BoincWrapper::beginCriticalSection();
-    
-    PopulationStats::print();
-    
-    sim::humanPop().flushReports();        // ensure all Human instances report past events
-    mon::writeSurveyData();
-    Continuous.finalise();
-    
-# ifdef OM_STREAM_VALIDATOR
-    util::StreamValidator.saveStream();
-# endif
 }
 
 
@@ -314,6 +383,7 @@ void Simulator::writeCheckpoint(){
         name << CHECKPOINT << checkpointNum;
         //Writing checkpoint:
 //      cerr << sim::now() << " WC: " << name.str();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
         if (util::CommandLine::option (util::CommandLine::COMPRESS_CHECKPOINTS)) {
             name << ".gz";
             ogzstream out(name.str().c_str(), ios::out | ios::binary);
@@ -324,6 +394,12 @@ void Simulator::writeCheckpoint(){
             checkpoint (out, checkpointNum);
             out.close();
         }
+        if (util::CommandLine::option (util::CommandLine::PRINT_PERF_STATS)) {
+            std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+            ifstream written(name.str().c_str(), ios::in | ios::binary | ios::ate);
+            cerr << "perf\tcheckpoint_write_s\t" << secs.count() << endl;
+            cerr << "perf\tcheckpoint_bytes\t" << written.tellg() << endl;
+        }
     }
     
     {   // Indicate which is the latest checkpoint file.
@@ -353,6 +429,7 @@ void Simulator::writeCheckpoint(){
 
 void Simulator::readCheckpoint() {
     int checkpointNum = readCheckpointNum();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
     
   // Open the latest file
   ostringstream name;
@@ -370,6 +447,10 @@ void Simulator::readCheckpoint() {
     checkpoint (in, checkpointNum);
     in.close();
   }
+  if (util::CommandLine::option (util::CommandLine::PRINT_PERF_STATS)) {
+    std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+    cerr << "perf\tcheckpoint_read_s\t" << secs.count() << endl;
+  }
   
   // Keep size of stderr.txt minimal with a short message, since this is a common message:
   cerr << sim::now().inSteps() << "t RC" << endl;
@@ -386,6 +467,16 @@ void Simulator::checkpoint (istream& stream, int checkpointNum) {
     try {
         util::checkpoint::header (stream);
         util::CommandLine::staticCheckpoint (stream);
+        SimTime oneTS;
+        oneTS & stream;
+        if( oneTS != SimTime::oneTS() ){
+            // written during a coarse warm-up: other data is for this step
+            if( !util::ModelOptions::option( util::COARSE_WARMUP ) )
+                throw util::checkpoint_error( "time step of checkpoint does not match scenario" );
+            const SimTime oldTS = SimTime::oneTS();
+            sim::setOneTS( oneTS );
+            Population::staticChangeTimeStep( oldTS );
+        }
         Population::staticCheckpoint (stream);
         Continuous & stream;
         mon::checkpoint( stream );
@@ -441,6 +532,8 @@ void Simulator::checkpoint (ostream& stream, int checkpointNum) {
     util::timer::startCheckpoint ();
     
     util::CommandLine::staticCheckpoint (stream);
+    SimTime oneTS = SimTime::oneTS();
+    oneTS & stream;
     Population::staticCheckpoint (stream);
     Continuous & stream;
     mon::checkpoint( stream );
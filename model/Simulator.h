@@ -42,13 +42,47 @@ public:
     //!  Inititalise all step specific constants and variables.
     Simulator( util::Checksum ck, const scnXml::Scenario& scenario );
     
+    /** Free static data set up by the constructor (also after it threw), so
+     * that another Simulator may be constructed in the same process. Call
+     * after destroying the Simulator. Not needed before exit. */
+    static void clearStatic();
+    
     //! Entry point to simulation.
     void start(const scnXml::Monitoring& monitoring);
     
+    /** @brief Step-wise operation
+     * 
+     * start() is equivalent to prepare(), run(SimTime::future()) and
+     * writing output; these allow an embedding application to stop and
+     * resume the simulation. Call prepare() once before run().
+     * 
+     * If resume is true, state is expected to be loaded next (by loadState
+     * or reading a checkpoint file) and the initial population is not
+     * created. */
+    //@{
+    void prepare(const scnXml::Monitoring& monitoring, bool resume);
+    /** Run until the end of the simulation or until intervention time
+     * reaches endTime (between steps), whichever is first. Returns true if
+     * the end of the simulation was reached. */
+    bool run(SimTime endTime);
+    //@}
+    
+    /** Write or read complete simulation state to/from a stream, in the
+     * checkpoint format. Random number generator state is included in the
+     * stream (not in a separate file). Call between steps. */
+    //@{
+    inline void saveState(ostream& stream){ checkpoint(stream, -1); }
+    inline void loadState(istream& stream){ checkpoint(stream, -1); }
+    //@}
+    
     /// Return true when this simulation started by loading a checkpoint
     inline static bool isCheckpoint(){ return startedFromCheckpoint; }
     
 private:
+    /** Change the time-step length to newTS, converting model state (model
+     * option COARSE_WARMUP). Call between steps. */
+    void changeTimeStep( SimTime newTS );
+    
     /** @brief checkpointing functions
     *
     * readCheckpoint/writeCheckpoint prepare to read/write the file,
@@ -64,6 +98,9 @@ private:
     // Data
     SimTime simPeriodEnd;
     SimTime totalSimDuration;
+    SimTime humanWarmupLength;
+    // Times at which to write a checkpoint and to exit (for testing)
+    SimTime testCheckpointTime, testCheckpointDieTime;
     int phase;  // only need be a class member because value is checkpointed
     
     /** This was used to prevent checksum cheats; now it is obseleted by cksum.
@@ -25,6 +25,7 @@
 #include "WithinHost/Genotypes.h"
 #include "util/vectors.h"
 #include "util/errors.h"
+#include "util/MemoryStats.h"
 
 #include <cmath>
 #include <boost/format.hpp>
@@ -361,6 +362,15 @@ void AnophelesModel::advancePeriod (
     }
 }
 
+void AnophelesModel::memoryStats( util::MemoryStats& stats )const{
+    stats.add( "vector species", 1, util::MemoryStats::bytes( trapParams ) +
+            util::MemoryStats::bytes( seekingDeathRateIntervs ) +
+            util::MemoryStats::bytes( probDeathOvipositingIntervs ) +
+            baitedTraps.size() * (sizeof(TrapData) + util::MemoryStats::LIST_NODE) +
+            util::MemoryStats::bytes( partialEIR ) );
+    transmission.memoryStats( stats );
+}
+
 }
 }
 }
@@ -227,6 +227,9 @@ public:
     inline void summarize( size_t species )const{
         transmission.summarize( species );
     }
+    
+    /// Add memory used by this species to stats
+    void memoryStats( util::MemoryStats& stats )const;
     //@}
     
 
@@ -27,6 +27,7 @@
 #include "util/errors.h"
 #include "util/ModelOptions.h"
 #include "util/StreamValidator.h"
+#include "util/MemoryStats.h"
 #include "schema/entomology.h"
 
 namespace OM {
@@ -324,6 +325,12 @@ double MosqTransmission::getLastVecStat( VecStat vs )const{
         default: throw SWITCH_DEFAULT_EXCEPTION;
     }
 }
+void MosqTransmission::memoryStats( util::MemoryStats& stats )const{
+    stats.add( "vector model arrays", 1, P_A.heapBytes() + P_df.heapBytes() +
+            P_dif.heapBytes() + P_dff.heapBytes() + N_v.heapBytes() +
+            O_v.heapBytes() + S_v.heapBytes() + fArray.heapBytes() +
+            ftauArray.heapBytes() + uninfected_v.heapBytes() );
+}
 void MosqTransmission::summarize( size_t species )const{
     // Last time step ended at sim::now(). Values are stored per day, and for
     // the last time step values at sim::now() and four previos were set.
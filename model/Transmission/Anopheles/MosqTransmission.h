@@ -30,6 +30,9 @@
 class MosqLifeCycleSuite;
 
 namespace OM {
+namespace util {
+    class MemoryStats;
+}
 namespace Transmission {
 namespace Anopheles {
 using util::vecDay2D;
@@ -160,6 +163,9 @@ public:
     
     /// Write some per-species summary information.
     void summarize( size_t species )const;
+    
+    /// Add memory used by per-day arrays to stats (emergence model excluded)
+    void memoryStats( util::MemoryStats& stats )const;
     //@}
     
     
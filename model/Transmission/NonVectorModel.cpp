@@ -26,6 +26,7 @@
 #include "util/random.h"
 #include "util/vectors.h"
 #include "util/StreamValidator.h"
+#include "util/MemoryStats.h"
 #include "util/checkpoint_containers.h"
 #include <limits>
 #include <cmath>
@@ -217,6 +218,28 @@ void NonVectorModel::update () {
     }
 }
 
+/** Convert buf, indexed by sim::ts1() (end of step) modulo its length, after
+ * the time-step length changed from oldTS; the new length is newLen. */
+static void changeTSEndIndexed( vector<double>& buf, size_t newLen, SimTime oldTS ){
+    // The step ending at ts1 is the one starting at ts1 - oneTS, thus
+    // index(ts1) = index(ts0) + 1.
+    vector<size_t> indices = vectors::changeTSIndices( buf.size(), oldTS,
+            newLen, SimTime::oneTS(), sim::latestTs0() );
+    vector<double> result( newLen );
+    for( size_t i = 0; i < newLen; ++i )
+        result[(i + 1) % newLen] = buf[(indices[i] + 1) % buf.size()];
+    buf.swap( result );
+}
+
+void NonVectorModel::changeTimeStep( SimTime oldTS ){
+    TransmissionModel::changeTimeStep( oldTS );
+    changeTSEndIndexed( laggedKappa, nSpore.inSteps() + 1, oldTS );
+    // only used while collecting data, before initIterate()
+    assert( simulationMode == forcedEIR );
+    changeTSEndIndexed( initialKappa,
+            SimTime::fromYearsI(nYearsWarmupData).inSteps(), oldTS );
+}
+
 
 double NonVectorModel::calculateEIR(Host::Human& human, double ageYears, vector<double>& EIR){
     EIR.resize( 1 );    // no support for per-genotype tracking in this model (possible, but we're lazy)
@@ -278,6 +301,12 @@ double NonVectorModel::averageEIR (const scnXml::NonVector& nonVectorData) {
     return valaverageEIR / i;
 }
 
+void NonVectorModel::memoryStats( util::MemoryStats& stats ) const{
+    TransmissionModel::memoryStats( stats );
+    stats.add( "transmission model", 0, util::MemoryStats::bytes( interventionEIR ) +
+            util::MemoryStats::bytes( initialKappa ) );
+}
+
 
 // -----  checkpointing  -----
 
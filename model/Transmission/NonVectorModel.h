@@ -73,8 +73,11 @@ public:
   
   virtual void vectorUpdate () {}
   virtual void update ();
+  virtual void changeTimeStep( SimTime oldTS );
   virtual double calculateEIR(OM::Host::Human& human, double ageYears, vector< double >& EIR);
   
+  virtual void memoryStats( util::MemoryStats& stats ) const;
+  
 private:
 
   /// Processes each daily EIR estimate, allocating each day in turn to the
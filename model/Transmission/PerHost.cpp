@@ -24,6 +24,7 @@
 #include "interventions/InterventionManager.hpp"
 #include "util/errors.h"
 #include "util/checkpoint.h"
+#include "util/MemoryStats.h"
 
 namespace OM {
 namespace Transmission {
@@ -55,6 +56,12 @@ void PerHost::initialise (double availabilityFactor) {
     }
 }
 
+void PerHost::reset () {
+    activeComponents.clear();
+    outsideTransmission = false;
+    _relativeAvailabilityHet = numeric_limits<double>::signaling_NaN();
+}
+
 void PerHost::update(Host::Human& human){
     for( ListActiveComponents::iterator it = activeComponents.begin(); it != activeComponents.end(); ++it ){
         it->update(human);
@@ -122,6 +129,14 @@ bool PerHost::hasActiveInterv(interventions::Component::Type type) const{
     return false;
 }
 
+void PerHost::memoryStats( util::MemoryStats& stats ) const{
+    stats.add( "transmission per-host (species)", species.size(),
+               util::MemoryStats::bytes( species ) );
+    for( ListActiveComponents::const_iterator it = activeComponents.begin(); it != activeComponents.end(); ++it ){
+        it->memoryStats( stats );
+    }
+}
+
 void PerHost::checkpointIntervs( ostream& stream ){
     activeComponents.size() & stream;
     for( boost::ptr_list<PerHostInterventionData>::iterator it = activeComponents.begin(); it != activeComponents.end(); ++it ){
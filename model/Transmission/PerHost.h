@@ -30,6 +30,9 @@
 #include <boost/ptr_container/ptr_list.hpp>
 
 namespace OM {
+namespace util {
+    class MemoryStats;
+}
 namespace Transmission {
 
 using Anopheles::PerHostAnophParams;
@@ -76,6 +79,9 @@ public:
     /// Get the mosquito fecundity multiplier (1 for no effect).
     virtual double relFecundity(size_t speciesIndex) const =0;
     
+    /// Add memory used by this object to stats
+    virtual void memoryStats( util::MemoryStats& stats ) const =0;
+    
     /// Index of effect describing the intervention
     inline interventions::ComponentId id() const { return m_id; }
     
@@ -131,6 +137,9 @@ public:
     //@{
     PerHost ();
     void initialise (double availabilityFactor);
+    /** Remove interventions and restore transmission, as for a new human.
+     * initialise() must be called afterwards. */
+    void reset ();
     //@}
     
     /// Call once per time step. Updates net holes.
@@ -256,6 +265,10 @@ public:
      * false). */
     bool hasActiveInterv( interventions::Component::Type type ) const;
     
+    /// Add memory used by per-species data and active components to stats
+    /// (this object itself is counted as part of Human).
+    void memoryStats( util::MemoryStats& stats ) const;
+    
     /// Checkpointing
     template<class S>
     void operator& (S& stream) {
@@ -31,6 +31,7 @@
 #include "util/BoincWrapper.h"
 #include "util/StreamValidator.h"
 #include "util/CommandLine.h"
+#include "util/MemoryStats.h"
 #include "util/vectors.h"
 #include "util/ModelOptions.h"
 
@@ -141,25 +142,62 @@ TransmissionModel::~TransmissionModel () {
 }
 
 
+TransmissionModel::KappaSums::KappaSums() :
+    time(SimTime::never()), sumWeight(0.0), sumWt_kappa(0.0), numTransmitting(0)
+{}
+void TransmissionModel::KappaSums::reset(){
+    time = sim::ts0();
+    sumWeight = 0.0;
+    sumWt_kappa = 0.0;
+    numTransmitting = 0;
+}
+void TransmissionModel::KappaSums::add( const Host::Human& human ){
+    //NOTE: calculate availability relative to age at end of time step;
+    // not my preference but consistent with TransmissionModel::getEIR().
+    const double avail = human.perHostTransmission.relativeAvailabilityHetAge(
+        human.age(sim::ts1()).inYears());
+    sumWeight += avail;
+    const double tbvFactor = human.getVaccine().getFactor( interventions::Vaccine::TBV );
+    const double pTransmit = human.withinHostModel->probTransmissionToMosquito( tbvFactor, 0 );
+    const double riskTrans = avail * pTransmit;
+    sumWt_kappa += riskTrans;
+    if( riskTrans > 0.0 )
+        ++numTransmitting;
+}
+
 double TransmissionModel::updateKappa () {
     // We calculate kappa for output and the non-vector model.
-    double sumWt_kappa= 0.0;
-    double sumWeight  = 0.0;
-    numTransmittingHumans = 0;
-
-    foreach(const Host::Human& human, sim::humanPop().crange()) {
-        //NOTE: calculate availability relative to age at end of time step;
-        // not my preference but consistent with TransmissionModel::getEIR().
-        const double avail = human.perHostTransmission.relativeAvailabilityHetAge(
-            human.age(sim::ts1()).inYears());
-        sumWeight += avail;
-        const double tbvFactor = human.getVaccine().getFactor( interventions::Vaccine::TBV );
-        const double pTransmit = human.withinHostModel->probTransmissionToMosquito( tbvFactor, 0 );
-        const double riskTrans = avail * pTransmit;
-        sumWt_kappa += riskTrans;
-        if( riskTrans > 0.0 )
-            ++numTransmittingHumans;
+    KappaSums sums;
+    if( m_fusedKappaSums.time == sim::ts0() ){
+        sums = m_fusedKappaSums;
+        m_fusedKappaSums.time = SimTime::never();       // don't use twice
+    }
+    if( sums.time != sim::ts0() ||
+        util::CommandLine::option( util::CommandLine::VERIFY_FUSED_UPDATE ) )
+    {
+        KappaSums popSums;
+        popSums.reset();
+        foreach(const Host::Human& human, sim::humanPop().crange()) {
+            popSums.add( human );
+        }
+        if( sums.time == sim::ts0() &&
+            (popSums.sumWeight != sums.sumWeight ||
+            popSums.sumWt_kappa != sums.sumWt_kappa ||
+            popSums.numTransmitting != sums.numTransmitting) )
+        {
+            ostringstream msg;
+            msg << "fused update: kappa sums differ from separate pass: "
+                << sums.sumWt_kappa << '/' << sums.sumWeight << " vs "
+                << popSums.sumWt_kappa << '/' << popSums.sumWeight
+                << " (transmitting humans: " << sums.numTransmitting
+                << " vs " << popSums.numTransmitting << ")";
+            throw TRACED_EXCEPTION_DEFAULT( msg.str() );
+        }
+        sums = popSums;
     }
+    const double sumWt_kappa = sums.sumWt_kappa;
+    const double sumWeight = sums.sumWeight;
+    numTransmittingHumans = sums.numTransmitting;
 
 
     size_t lKMod = sim::ts1().moduloSteps(laggedKappa.size());	// now
@@ -194,6 +232,25 @@ double TransmissionModel::updateKappa () {
     return laggedKappa[lKMod];  // kappa now
 }
 
+void TransmissionModel::changeTimeStep( SimTime oldTS ){
+    // Kappa is summed over whole years; a switch is only made between years
+    assert( _sumAnnualKappa == 0.0 );
+    if( SimTime::oneTS() == sim::scenarioTS() ){
+        assert( !initialisationEIRScenarioTS.empty() );
+        initialisationEIR.swap( initialisationEIRScenarioTS );
+        initialisationEIRScenarioTS.clear();
+    }else{
+        assert( oldTS == sim::scenarioTS() );
+        // Sum the EIR over each new step
+        const size_t ratio = SimTime::oneTS().inDays() / oldTS.inDays();
+        assert( initialisationEIR.size() == SimTime::stepsPerYear() * ratio );
+        initialisationEIRScenarioTS = initialisationEIR;
+        initialisationEIR.assign( SimTime::stepsPerYear(), 0.0 );
+        for( size_t i = 0; i < initialisationEIRScenarioTS.size(); ++i )
+            initialisationEIR[i / ratio] += initialisationEIRScenarioTS[i];
+    }
+}
+
 double TransmissionModel::getEIR( Host::Human& human, SimTime age,
                     double ageYears, vector<double>& EIR )
 {
@@ -217,6 +274,12 @@ double TransmissionModel::getEIR( Host::Human& human, SimTime age,
     return allEIR;
 }
 
+void TransmissionModel::memoryStats( util::MemoryStats& stats ) const{
+    stats.add( "transmission model", 1, util::MemoryStats::bytes( initialisationEIR ) +
+            util::MemoryStats::bytes( laggedKappa ) +
+            util::MemoryStats::bytes( surveyInoculations ) );
+}
+
 void TransmissionModel::summarize () {
     mon::reportStatMF( mon::MVF_NUM_TRANSMIT, laggedKappa[sim::now().moduloSteps(laggedKappa.size())] );
     mon::reportStatMF( mon::MVF_ANN_AVG_K, _annualAverageKappa );
@@ -256,6 +319,7 @@ void TransmissionModel::checkpoint (istream& stream) {
     simulationMode & stream;
     interventionMode & stream;
     initialisationEIR & stream;
+    initialisationEIRScenarioTS & stream;
     laggedKappa & stream;
     annualEIR & stream;
     _annualAverageKappa & stream;
@@ -274,6 +338,7 @@ void TransmissionModel::checkpoint (ostream& stream) {
     simulationMode & stream;
     interventionMode & stream;
     initialisationEIR & stream;
+    initialisationEIRScenarioTS & stream;
     laggedKappa & stream;
     annualEIR & stream;
     _annualAverageKappa & stream;
@@ -31,6 +31,7 @@
 namespace OM {
     class Summary;
 namespace Host{ class Human; }
+namespace util{ class MemoryStats; }
 namespace Transmission {
     class PerHost;
 
@@ -109,6 +110,11 @@ public:
    * Overriding functions should call this base version too. */
   virtual void summarize ();
   
+  /** Add memory used by the model to stats.
+   *
+   * Overriding functions should call this base version too. */
+  virtual void memoryStats( util::MemoryStats& stats ) const;
+  
   /** Scale the EIR used by the model.
    *
    * EIR is scaled in memory (so will affect this simulation).
@@ -151,6 +157,14 @@ public:
    * the non-vector model (when in use). */
   virtual void update () =0;
   
+  /** Convert data stored per time step after the time-step length changed
+   * from oldTS to SimTime::oneTS() (model option COARSE_WARMUP). Only
+   * changes between the scenario's step and a multiple of it, at the start
+   * of a year, are supported.
+   * 
+   * Data held per day (e.g. in the vector model) needs no conversion. */
+  virtual void changeTimeStep( SimTime oldTS );
+  
   virtual void changeEIRIntervention (const scnXml::NonVector&) {
       throw util::xml_scenario_error("changeEIR intervention can only be used with NonVectorModel!");
   }
@@ -205,6 +219,30 @@ public:
    * infection, humans will then be exposed to zero EIR. */
   virtual void uninfectVectors() =0;
   
+  /** Sums over the population used to calculate kappa.
+   * 
+   * These are normally collected during the human update pass
+   * (Population::update1()), after each human's update, saving updateKappa()
+   * a pass over the population. The order of summation is the same, so
+   * results are identical. */
+  class KappaSums {
+  public:
+      KappaSums();
+      /// Start collecting sums for the current time step
+      void reset();
+      /// Add a human (after its update and only if it survives the step)
+      void add( const Host::Human& human );
+  private:
+      SimTime time;     // sim::ts0() at reset(), or SimTime::never()
+      double sumWeight, sumWt_kappa;
+      int numTransmitting;
+      friend class TransmissionModel;
+  };
+  
+  /// Sums filled in by the human update pass (not checkpointed: only used
+  /// within the step)
+  inline KappaSums& fusedKappaSums(){ return m_fusedKappaSums; }
+  
 protected:
   /** Calculates the EIR individuals are exposed to.
    * 
@@ -220,7 +258,10 @@ protected:
   
   /** Needs to be called each time-step after Human::update() to update summary
    * statististics related to transmission. Also returns kappa (the average
-   * human infectiousness weighted by availability to mosquitoes). */
+   * human infectiousness weighted by availability to mosquitoes).
+   * 
+   * Uses fusedKappaSums() if these were collected this step, otherwise sums
+   * over the population. */
   double updateKappa ();
   
   virtual void checkpoint (istream& stream);
@@ -254,6 +295,11 @@ protected:
    * Not checkpointed; doesn't need to be except when a changeEIR intervention
    * occurs. */
   vector<double> initialisationEIR; 
+  
+  /** While the time step is longer than the scenario's (see
+   * changeTimeStep()), initialisationEIR for the scenario's time step, to
+   * be restored later; otherwise empty. Checkpointed. */
+  vector<double> initialisationEIRScenarioTS;
 
   /** The probability of infection of a mosquito at each bite.
    * It is calculated as the average infectiousness per human.
@@ -308,6 +354,8 @@ private:
   /// accumulator for time step adults requesting EIR
   int tsNumAdults;
   
+  KappaSums m_fusedKappaSums;
+  
     /// Total inoculations since last survey (multidimensional).
     /// See survInocsSize, survInocsIndex in cpp file.
     vector<double> surveyInoculations;
@@ -27,6 +27,7 @@
 #include "util/vectors.h"
 #include "util/ModelOptions.h"
 #include "util/SpeciesIndexChecker.h"
+#include "util/MemoryStats.h"
 
 #include <fstream>
 #include <map>
@@ -557,6 +558,15 @@ void VectorModel::summarize () {
     }
 }
 
+void VectorModel::memoryStats( util::MemoryStats& stats ) const{
+    TransmissionModel::memoryStats( stats );
+    stats.add( "vector model arrays", 1, saved_sum_avail.heapBytes() +
+            saved_sigma_df.heapBytes() + saved_sigma_dif.heapBytes() );
+    for(size_t i = 0; i < numSpecies; ++i){
+        species[i].memoryStats( stats );
+    }
+}
+
 
 void VectorModel::checkpoint (istream& stream) {
     TransmissionModel::checkpoint (stream);
@@ -25,6 +25,7 @@
 #include "Transmission/TransmissionModel.h"
 #include "Transmission/Anopheles/AnophelesModel.h"
 
+class ModelFixture;
 namespace scnXml {
   class Vector;
 }
@@ -71,6 +72,7 @@ public:
   virtual void uninfectVectors();
   
   virtual void summarize ();
+  virtual void memoryStats( util::MemoryStats& stats ) const;
   
 protected:
     virtual void checkpoint (istream& stream);
@@ -135,6 +137,7 @@ private:
   
   friend class PerHost;
   friend class AnophelesModelSuite;
+  friend class ::ModelFixture;
 };
 
 } }
@@ -28,6 +28,7 @@
 #include "util/random.h"
 #include "util/StreamValidator.h"
 #include "schema/scenario.h"
+#include "util/MemoryStats.h"
 
 #include <boost/algorithm/string.hpp>
 
@@ -73,7 +74,17 @@ CommonWithinHost::CommonWithinHost( double comorbidityFactor ) :
         WHFalciparum( comorbidityFactor )
 {
     assert( SimTime::oneTS() == SimTime::fromDays(1) || SimTime::oneTS() == SimTime::fromDays(5) );
-    
+    sampleHetMass();
+}
+
+void CommonWithinHost::reset( double comorbidityFactor ){
+    WHFalciparum::reset( comorbidityFactor );
+    clearInfections( Treatments::BOTH );
+    pkpdModel.reset();
+    sampleHetMass();
+}
+
+void CommonWithinHost::sampleHetMass(){
     // Sample a weight heterogeneity factor
 #ifndef NDEBUG
     int counter = 0;
@@ -151,6 +162,18 @@ void CommonWithinHost::update(int nNewInfs, vector<double>& genotype_weights,
         m_y_lag.at( y_lag_i, (*inf)->genotype() ) += (*inf)->getDensity();
     }
     
+    if( nNewInfs == 0 && infections.empty() && pkpdModel.isIdle() ){
+        // Quiescent host: no infections and drugs cleared, so only immunity decays.
+        // The daily loop below would not change anything else.
+#ifdef WITHOUT_BOINC
+        ++PopulationStats::quiescentWHUpdates;
+#endif
+        updateImmuneStatus ();
+        totalDensity = 0.0;
+        timeStepMaxDensity = 0.0;
+        return;
+    }
+    
     // Note: adding infections at the beginning of the update instead of the end
     // shouldn't be significant since before latentp delay nothing is updated.
     PopulationStats::totalInfections += nNewInfs;
@@ -179,6 +202,8 @@ void CommonWithinHost::update(int nNewInfs, vector<double>& genotype_weights,
     double survivalFactor_part = bsvFactor * _innateImmSurvFact;
     
     double body_mass = massByAge.eval( ageInYears ) * hetMassMultiplier;
+    // immunity terms common to all infections, constant over the time step
+    const Infection::HostImmunity hostImm = Infection::hostImmunity(ageInYears, cumulative_h, cumulative_Y);
     
     for( SimTime now = sim::ts0(), end = sim::ts0() + SimTime::oneTS(); now < end; now += SimTime::oneDay() ){
         // every day, medicate drugs, update each infection, then decay drugs
@@ -192,7 +217,7 @@ void CommonWithinHost::update(int nNewInfs, vector<double>& genotype_weights,
             
             if( !expires ){     /* no expiry due to simple treatment model; do update */
                 const double drugFactor = pkpdModel.getDrugFactor(*inf, body_mass);
-                const double immFactor = (*inf)->immunitySurvivalFactor(ageInYears, cumulative_h, cumulative_Y);
+                const double immFactor = (*inf)->immunitySurvivalFactor(hostImm);
                 const double survivalFactor = survivalFactor_part * immFactor * drugFactor;
                 // update, may result in termination of infection:
                 expires = (*inf)->update(survivalFactor, now, body_mass);
@@ -229,8 +254,8 @@ void CommonWithinHost::addProphylacticEffects(const vector<double>& pClearanceBy
 
 // -----  Summarize  -----
 
-// Used in summarizeInfs.
-vector<CommonInfection*> sortedInfs;
+// Used in summarize(); per thread since humans may be summarized concurrently.
+thread_local vector<CommonInfection*> sortedInfs;
 struct InfGenotypeSorter {
     bool operator() (CommonInfection* i, CommonInfection* j){
         return i->genotype() < j->genotype();
@@ -290,6 +315,16 @@ bool CommonWithinHost::summarize( const Host::Human& human )const{
     return false;       // not patent
 }
 
+void CommonWithinHost::memoryStats( util::MemoryStats& stats )const{
+    stats.add( "within-host model (common)", 1, sizeof(*this) + infections.size() *
+            (sizeof(CommonInfection*) + util::MemoryStats::LIST_NODE) );
+    memoryStatsWHF( stats );
+    pkpdModel.memoryStats( stats );
+    foreach( const CommonInfection* inf, infections ){
+        inf->memoryStats( stats );
+    }
+}
+
 
 void CommonWithinHost::checkpoint (istream& stream) {
     WHFalciparum::checkpoint (stream);
@@ -44,6 +44,7 @@ public:
     CommonWithinHost( double comorbidityFactor );
     virtual ~CommonWithinHost();
     
+    virtual void reset( double comorbidityFactor );
     
     virtual void importInfection();
     
@@ -67,6 +68,7 @@ public:
     //@}
     
     virtual bool summarize( const Host::Human& human )const;
+    virtual void memoryStats( util::MemoryStats& stats ) const;
     
 protected:
     virtual void clearInfections( Treatments::Stages stage );
@@ -75,6 +77,9 @@ protected:
     virtual void checkpoint (ostream& stream);
     
 private:
+    /// Sample hetMassMultiplier
+    void sampleHetMass();
+    
     /// Multiplies the mean mass (for this age) as a heterogeneity factor.
     double hetMassMultiplier;
     
@@ -27,6 +27,7 @@
 #include "PopulationStats.h"
 #include "util/StreamValidator.h"
 #include "util/errors.h"
+#include "util/MemoryStats.h"
 #include <cassert>
 
 using namespace std;
@@ -51,6 +52,11 @@ DescriptiveWithinHostModel::DescriptiveWithinHostModel( double comorbidityFactor
 
 DescriptiveWithinHostModel::~DescriptiveWithinHostModel() {}
 
+void DescriptiveWithinHostModel::reset( double comorbidityFactor ){
+    WHFalciparum::reset( comorbidityFactor );
+    infections.clear();
+}
+
 
 // -----  Simple infection adders/removers  -----
 
@@ -128,6 +134,10 @@ void DescriptiveWithinHostModel::update(int nNewInfs, vector<double>& genotype_w
     bool treatmentLiver = treatExpiryLiver > sim::ts0();
     bool treatmentBlood = treatExpiryBlood > sim::ts0();
     
+    // terms common to all infections of this host
+    const Infection::HostImmunity hostImm = Infection::hostImmunity(ageInYears, cumulative_h, cumulative_Y);
+    const double stdlog = DescriptiveInfection::densityStdLog(cumulative_h);
+    
     for(std::list<DescriptiveInfection>::iterator inf = infections.begin(); inf != infections.end();) {
         //NOTE: it would be nice to combine this code with that in
         // CommonWithinHost.cpp, but a few changes would be needed:
@@ -147,7 +157,7 @@ void DescriptiveWithinHostModel::update(int nNewInfs, vector<double>& genotype_w
         // Should be: infStepMaxDens = 0.0, but has some history.
         // See MAX_DENS_CORRECTION in DescriptiveInfection.cpp.
         double infStepMaxDens = timeStepMaxDensity;
-        inf->determineDensities(ageInYears, cumulative_h, cumulative_Y, infStepMaxDens, _innateImmSurvFact, bsvFactor);
+        inf->determineDensities(hostImm, stdlog, infStepMaxDens, _innateImmSurvFact, bsvFactor);
 
         if (bugfix_max_dens)
             infStepMaxDens = std::max(infStepMaxDens, timeStepMaxDensity);
@@ -195,6 +205,13 @@ bool DescriptiveWithinHostModel::summarize( const Host::Human& human )const{
     return false;       // not patent
 }
 
+void DescriptiveWithinHostModel::memoryStats( util::MemoryStats& stats )const{
+    stats.add( "within-host model (descriptive)", 1, sizeof(*this) );
+    memoryStatsWHF( stats );
+    stats.add( "infection (descriptive)", infections.size(), infections.size() *
+            (sizeof(DescriptiveInfection) + util::MemoryStats::LIST_NODE) );
+}
+
 
 // -----  Data checkpointing  -----
 
@@ -43,6 +43,7 @@ public:
     DescriptiveWithinHostModel( double comorbidityFactor );
     virtual ~DescriptiveWithinHostModel();
     
+    virtual void reset( double comorbidityFactor );
     virtual void importInfection();
     /// load an infection from a checkpoint
     virtual void loadInfection(istream& stream);
@@ -52,6 +53,7 @@ public:
             double ageInYears, double bsvFactor);
     
     virtual bool summarize( const Host::Human& human )const;
+    virtual void memoryStats( util::MemoryStats& stats ) const;
     
 protected:
     virtual void clearInfections( Treatments::Stages stage );
@@ -112,6 +112,10 @@ bool Diagnostic::allowsFalsePositives() const{
     return specificity < 1.0;
 }
 
+bool Diagnostic::isDeterministic() const{
+    return (boost::math::isnan)(specificity);
+}
+
 
 // ———  diagnostics (static)  ———
 
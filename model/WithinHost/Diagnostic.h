@@ -49,6 +49,9 @@ public:
     /// True if false positives are possible
     bool allowsFalsePositives() const;
     
+    /// True if the outcome depends only on density (no random draws)
+    bool isDeterministic() const;
+    
 private:
     /** Construct from XML parameters. */
     Diagnostic( const Parameters& parameters, const scnXml::Diagnostic& elt );
@@ -79,6 +82,9 @@ public:
     
     /** Make a new diagnostic with deterministic density and return a reference. */
     static const Diagnostic& make_deterministic( double minDens );
+    
+    /** Free all diagnostics (for unit tests and Simulator::clearStatic()). */
+    static void clear();
 
     /// Static access functions
 
@@ -89,7 +95,6 @@ public:
 
     
 private:
-    static void clear();        // for unit tests
     static const Diagnostic* monitoring_diagnostic;
     friend class ::UnittestUtil;
 };
@@ -115,6 +115,11 @@ bool contains(const vector<T>& vec, const T& x){
 }
 
 void Genotypes::init( const scnXml::Scenario& scenario ){
+    // clear any state from a previous simulation (in the same process)
+    GT::cum_initial_freqs.clear();
+    GT::alleleCodes.clear();
+    GT::nextAlleleCode = 0;
+    
     if( scenario.getParasiteGenetics().present() ){
         const scnXml::ParasiteGenetics& genetics =
             scenario.getParasiteGenetics().get();
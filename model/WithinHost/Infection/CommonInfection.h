@@ -23,7 +23,11 @@
 
 #include "WithinHost/Infection/Infection.h"
 
-namespace OM { namespace WithinHost {
+namespace OM {
+namespace util {
+    class MemoryStats;
+}
+namespace WithinHost {
 
 /** Represent infections used by CommonWithinHost.
  * 
@@ -63,7 +67,12 @@ public:
 	    return updateDensity( survivalFactor, bsAge, body_mass );
     }
     
-    map<size_t, double> Kn; // IC50^slope per drug type, if sampled
+    /// IC50^slope per drug in use, indexed by position in
+    /// LSTMDrugType::getDrugsInUse(); NaN where not yet sampled.
+    vector<double> Kn;
+    
+    /// Add memory used by this infection
+    virtual void memoryStats( util::MemoryStats& stats ) const =0;
     
 protected:
     /** Update: calculate new density.
@@ -37,6 +37,7 @@ vector<DescriptiveIPTInfection::GenotypeData> DescriptiveIPTInfection::genotypes
 // Only called if IPT is present
 void DescriptiveIPTInfection::initParameters (const scnXml::IPTDescription& xmlIPTI){
   const scnXml::IPTDescription::InfGenotypeSequence& genotypesData = xmlIPTI.getInfGenotype();
+  genotypes.clear();
   genotypes.reserve (genotypesData.size());
   
   double genotypeCumFreq = 0.0;
@@ -35,7 +35,7 @@ namespace WithinHost {
 using namespace util;
 
 // static class variables (see description in header file):
-double DescriptiveInfection::meanLogParasiteCount[numDurations][numDurations];
+double DescriptiveInfection::meanDensity[numDurations][numDurations];
 double DescriptiveInfection::sigma0sq;
 double DescriptiveInfection::xNuStar;
 
@@ -49,7 +49,7 @@ void DescriptiveInfection::init (const Parameters& parameters) {
     if( SimTime::oneTS().inDays() != 5 ){
         // To support non-5-day time-step models, either different data would
         // be needed or times need to be adjusted when accessing
-        // meanLogParasiteCount. Probably the rest would be fine.
+        // meanDensity. Probably the rest would be fine.
         throw util::xml_scenario_error ("DescriptiveInfection only supports using an interval of 5");
     }
     // Bug fixes: these are enabled by default but may be off in old parameterisations
@@ -102,11 +102,11 @@ void DescriptiveInfection::init (const Parameters& parameters) {
                 .append(densities_filename), Error::InputResource );
         }
 
-        //fill initial matrix
-        meanLogParasiteCount[i-1][j-1]=meanlogdens;
+        //fill initial matrix (exponentiated here rather than per infection)
+        meanDensity[i-1][j-1]=max(exp(meanlogdens), 1.0);
         //fill also the triangle that will not be used (to ensure everything is initialised)
         if (j!=i) {
-            meanLogParasiteCount[j-1][i-1]=0.0;
+            meanDensity[j-1][i-1]=1.0;
         }
 
     }
@@ -140,9 +140,8 @@ SimTime DescriptiveInfection::infectionDuration() {
 
 // ———  time-step updates  ———
 
-void DescriptiveInfection::determineDensities(double ageInYears,
-                                              double cumulativeh,
-                                              double cumulativeY,
+void DescriptiveInfection::determineDensities(const HostImmunity& hostImm,
+                                              double stdlog,
                                               double &timeStepMaxDensity,
                                               double innateImmSurvFact,
                                               double bsvFactor)
@@ -158,15 +157,13 @@ void DescriptiveInfection::determineDensities(double ageInYears,
         
         int32_t infAge = min( infage.inSteps(), maxDurationTS );
         int32_t infDur = min( m_duration.inSteps(), maxDurationTS );
-        m_density=max (exp(meanLogParasiteCount[infAge][infDur]), 1.0);
+        m_density=meanDensity[infAge][infDur];
         
         // The expected parasite density in the non naive host (AJTM p.9 eq. 9)
         // Note that in published and current implementations Dx is zero.
-        m_density = pow(m_density, immunitySurvivalFactor(ageInYears, cumulativeh, cumulativeY));
+        m_density = pow(m_density, immunitySurvivalFactor(hostImm));
         
-        //Perturb m_density using a lognormal
-        double varlog = sigma0sq / (1.0 + (cumulativeh / xNuStar));
-        double stdlog = sqrt(varlog);
+        //Perturb m_density using a lognormal (stdlog: see densityStdLog())
         
         /*
         This code samples from a log normal distribution with mean equal to the predicted density
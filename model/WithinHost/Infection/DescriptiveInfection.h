@@ -21,6 +21,7 @@
 #ifndef Hmod_DescriptiveInfection
 #define Hmod_DescriptiveInfection
 #include "WithinHost/Infection/Infection.h"
+#include <cmath>
 
 namespace OM { namespace WithinHost {
 
@@ -40,7 +41,7 @@ const double maxDens = 2000000;
  * 
  * This model was designed primarily for usage with a 5-day time-step, but is
  * mostly applicable to 1-4 day time-steps too. In such cases the indexes used
- * to access meanLogParasiteCount (or the data contained) would need adjusting.
+ * to access meanDensity (or the data contained) would need adjusting.
  * 
  * Note that this class models only a single infection; for the associated
  * handling of multiple infections see the DescriptiveWithinHostModel class.
@@ -73,19 +74,26 @@ public:
         return sim::ts0() > m_startDate + m_duration;
     }
     
+    /** Standard deviation of the log-normal density perturbation (AJTM p.9
+     * eq. 13); depends only on the host's cumulative number of infections. */
+    static inline double densityStdLog(double cumulativeh){
+        double varlog = sigma0sq / (1.0 + (cumulativeh / xNuStar));
+        return sqrt(varlog);
+    }
+    
     /** Determines parasite density of an individual infection (5-day time step
      * update)
      *
-     * @param ageInYears Age (of human)
-     * @param cumulativeh Cumulative number of infections
-     * @param cumulativeY Previous exposure (cumulative parasite density)
+     * @param hostImm Host terms of the immunity survival factor (from
+     *  Infection::hostImmunity(), given age, cumulative h and cumulative Y)
+     * @param stdlog Result of densityStdLog() for the host
      * @param timeStepMaxDensity (In-out param) Used to return the maximum
      *  parasite density over a 5-day interval.
      * @param innateImmSurvFact Density multiplier for innate immunity.
      * @param bsvFactor Density multiplier for Blood-Stage Vaccine effect.
      */
-    void determineDensities(double ageInYears, double cumulativeh,
-                            double cumulativeY, double &timeStepMaxDensity,
+    void determineDensities(const HostImmunity& hostImm, double stdlog,
+                            double &timeStepMaxDensity,
                             double innateImmSurvFact, double bsvFactor);
     
     /** Decide on an infection duration and return it.
@@ -112,10 +120,10 @@ protected:
 private:
     /// @brief Static parameters set by init()
     //@{
-    /* A triangular matrix: meanLogParasiteCount[i][j] is the
-     * Mean Log Parasite Count for age i (in time steps) of an infection which
-     * lasts j days. Indices with i>j are unused. */
-    static double meanLogParasiteCount[numDurations][numDurations];
+    /* A triangular matrix: meanDensity[i][j] is max(exp(x), 1) where x is
+     * the Mean Log Parasite Count for age i (in time steps) of an infection
+     * which lasts j days. Indices with i>j are unused. */
+    static double meanDensity[numDurations][numDurations];
     
     /// Sigma0^2 from AJTM p.9 eq. 13
     static double sigma0sq;
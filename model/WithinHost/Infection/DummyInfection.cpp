@@ -20,6 +20,7 @@
 
 #include "WithinHost/Infection/DummyInfection.h"
 #include "WithinHost/CommonWithinHost.h"
+#include "util/MemoryStats.h"
 #include "util/random.h"
 #include "util/ModelOptions.h"
 
@@ -66,4 +67,9 @@ DummyInfection::DummyInfection (istream& stream) :
     CommonInfection (stream)
 {}
 
+void DummyInfection::memoryStats( util::MemoryStats& stats ) const{
+    stats.add( "infection (dummy)", 1, sizeof(*this)
+            + util::MemoryStats::bytes( Kn ) );
+}
+
 } }
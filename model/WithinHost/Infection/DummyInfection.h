@@ -44,6 +44,8 @@ public:
     static void init ();
     
     virtual bool updateDensity( double survivalFactor, SimTime bsAge, double );
+    
+    virtual void memoryStats( util::MemoryStats& stats ) const;
 };
 
 } }
@@ -20,6 +20,7 @@
 
 #include "WithinHost/Infection/EmpiricalInfection.h"
 #include "WithinHost/CommonWithinHost.h"
+#include "util/MemoryStats.h"
 #include "util/random.h"
 #include "util/errors.h"
 #include "util/CommandLine.h"
@@ -282,4 +283,9 @@ void EmpiricalInfection::checkpoint (ostream& stream) {
     _patentGrowthRateMultiplier & stream;
 }
 
+void EmpiricalInfection::memoryStats( util::MemoryStats& stats ) const{
+    stats.add( "infection (empirical)", 1, sizeof(*this)
+            + util::MemoryStats::bytes( Kn ) );
+}
+
 } }
@@ -55,6 +55,8 @@ public:
   
     virtual bool updateDensity( double survivalFactor, SimTime bsAge, double );
   
+    virtual void memoryStats( util::MemoryStats& stats ) const;
+  
 protected:
     virtual void checkpoint (ostream& stream);
     
@@ -43,23 +43,29 @@ void Infection::init (const OM::Parameters& parameters, SimTime latP) {
 
 
 double Infection::immunitySurvivalFactor (double ageInYears, double cumulativeh, double cumulativeY) {
+  return immunitySurvivalFactor( hostImmunity( ageInYears, cumulativeh, cumulativeY ) );
+}
+
+Infection::HostImmunity Infection::hostImmunity (double ageInYears, double cumulativeh, double cumulativeY) {
   //Documentation: AJTMH pp22-23
-  //effect of cumulative Parasite density (named Dy in AJTM)
-  double dY;
-  //effect of number of infections experienced since birth (named Dh in AJTM)
-  double dH;
-  //effect of age-dependent maternal immunity (named Dm in AJTM)
-  double dA;
-  
-  if (cumulativeh <= 1.0) {
-    dY=1.0;
-    dH=1.0;
+  HostImmunity host;
+  host.naive = cumulativeh <= 1.0;
+  if (host.naive) {
+    host.cumulativeY = 0.0;     // unused
+    host.dH=1.0;
   } else {
-    dH=1.0 / (1.0 + (cumulativeh-1.0) * invCumulativeHstar);
-    dY=1.0 / (1.0 + (cumulativeY - m_cumulativeExposureJ) * invCumulativeYstar);
+    host.cumulativeY = cumulativeY;
+    host.dH=1.0 / (1.0 + (cumulativeh-1.0) * invCumulativeHstar);
   }
-  dA = 1.0 - alpha_m * exp(-decayM * ageInYears);
-  double ret = std::min(dY*dH*dA, 1.0);
+  host.dA = 1.0 - alpha_m * exp(-decayM * ageInYears);
+  return host;
+}
+
+double Infection::immunitySurvivalFactor (const HostImmunity& host) {
+  //effect of cumulative Parasite density (named Dy in AJTM)
+  double dY = host.naive ? 1.0 :
+      1.0 / (1.0 + (host.cumulativeY - m_cumulativeExposureJ) * invCumulativeYstar);
+  double ret = std::min(dY*host.dH*host.dA, 1.0);
   util::streamValidate( ret );
   return ret;
 }
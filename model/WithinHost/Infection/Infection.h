@@ -75,6 +75,20 @@ public:
      * time step). */
     double immunitySurvivalFactor (double ageInYears, double cumulativeh, double cumulativeY);
     
+    /** The terms of immunitySurvivalFactor() which depend only on the host.
+     * These are the same for all of a host's infections during a time step,
+     * so the host computes them once (with hostImmunity()). */
+    struct HostImmunity {
+        bool naive;     // cumulative h <= 1: no acquired immunity
+        double cumulativeY;     // cumulative parasite density of host
+        double dH;      // effect of number of infections (Dh in AJTM)
+        double dA;      // effect of maternal immunity (Dm in AJTM)
+    };
+    static HostImmunity hostImmunity (double ageInYears, double cumulativeh, double cumulativeY);
+    
+    /// As above, but using precomputed host terms.
+    double immunitySurvivalFactor (const HostImmunity& host);
+    
     /// Resets immunity properties specific to the infection (should only be
     /// called along with clearImmunity() on within-host model).
     inline void clearImmunity(){
@@ -20,6 +20,7 @@
 
 #include "WithinHost/Infection/MolineauxInfection.h"
 #include "WithinHost/CommonWithinHost.h"
+#include "util/MemoryStats.h"
 #include "util/random.h"
 #include "util/errors.h"
 #include "util/CommandLine.h"
@@ -452,5 +453,10 @@ void MolineauxInfection::Variant::operator& (ostream& stream) {
     }
 }
 
+void MolineauxInfection::memoryStats( util::MemoryStats& stats ) const{
+    stats.add( "infection (Molineaux)", 1, sizeof(*this)
+            + util::MemoryStats::bytes( Kn ) + util::MemoryStats::bytes( variants ) );
+}
+
 }
 }
@@ -58,6 +58,8 @@ public:
     
     virtual bool updateDensity( double survivalFactor, SimTime bsAge, double body_mass );
     
+    virtual void memoryStats( util::MemoryStats& stats ) const;
+    
 protected:
     virtual void checkpoint (ostream& stream);
     
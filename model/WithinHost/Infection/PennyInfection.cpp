@@ -20,6 +20,7 @@
 
 #include "WithinHost/Infection/PennyInfection.h"
 #include "WithinHost/CommonWithinHost.h"
+#include "util/MemoryStats.h"
 #include "util/random.h"
 #include "util/errors.h"
 #include "util/CommandLine.h"
@@ -352,5 +353,10 @@ void PennyInfection::checkpoint (ostream& stream) {
     clonalSummation & stream;
 }
 
+void PennyInfection::memoryStats( util::MemoryStats& stats ) const{
+    stats.add( "infection (Penny)", 1, sizeof(*this)
+            + util::MemoryStats::bytes( Kn ) );
+}
+
 }
 }
\ No newline at end of file
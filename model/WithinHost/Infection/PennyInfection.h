@@ -44,6 +44,8 @@ public:
     
     virtual bool updateDensity( double survivalFactor, SimTime bsAge, double );
     
+    virtual void memoryStats( util::MemoryStats& stats ) const;
+    
     /** Get the density of sequestered parasites. */
     inline double seqDensity(int ageDays){
         size_t todayV = mod_nn(ageDays, delta_V);
@@ -80,6 +80,14 @@ void PathogenesisModel::init( const Parameters& parameters, const scnXml::Clinic
     }
 }
 
+void PathogenesisModel::staticChangeTimeStep(){
+    if( opt_mueller_pres_model ){
+        MuellerPathogenesis::staticChangeTimeStep();
+    }else{
+        PyrogenPathogenesis::staticChangeTimeStep();
+    }
+}
+
 PathogenesisModel* PathogenesisModel::createPathogenesisModel(double cF) {
     if (opt_predetermined_episodes) {
         return new PredetPathogenesis(cF);
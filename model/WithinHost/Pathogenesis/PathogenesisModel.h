@@ -41,6 +41,9 @@ class PathogenesisModel {
 public:
     /// Calls static init on correct PathogenesisModel.
     static void init( const Parameters& parameters, const scnXml::Clinical& clinical, bool nmfOnly );
+    
+    /// Adjust static parameters to the current time-step length.
+    static void staticChangeTimeStep();
 
     /** Create a sub-class instance, dependant on global options.
     *
@@ -49,6 +52,12 @@ public:
     
     
     virtual ~PathogenesisModel() {}
+    
+    /** Return to the state of a newly created model with comorbidity
+     * factor cF (for reuse by a new human). */
+    virtual void reset( double cF ){
+        _comorbidityFactor = cF;
+    }
 
     /** Determines the health of the individual based on his/her parasitemia.
      *
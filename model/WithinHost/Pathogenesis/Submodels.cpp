@@ -34,11 +34,16 @@ namespace Pathogenesis {
 // Müller model parameters
 double rateMultiplier_31;
 double densityExponent_32;
+// rate multiplier per year (input parameter)
+double rateMultiplierAnnual = numeric_limits<double>::signaling_NaN();
 
 void MuellerPathogenesis::init( const Parameters& parameters ){
-    rateMultiplier_31 = parameters[Parameters::MUELLER_RATE_MULTIPLIER]
-        * SimTime::yearsPerStep();
+    rateMultiplierAnnual = parameters[Parameters::MUELLER_RATE_MULTIPLIER];
     densityExponent_32 = parameters[Parameters::MUELLER_DENSITY_EXPONENT];
+    staticChangeTimeStep();
+}
+void MuellerPathogenesis::staticChangeTimeStep(){
+    rateMultiplier_31 = rateMultiplierAnnual * SimTime::yearsPerStep();
 }
 
 double MuellerPathogenesis::getPEpisode(double, double totalDensity) {
@@ -61,29 +66,36 @@ const size_t n = 11;
 // Derived parameters without good names:
 double a = numeric_limits<double>::signaling_NaN(),
     b = numeric_limits<double>::signaling_NaN();
+// Input parameters used to derive a and b
+double Ystar_halfLife = numeric_limits<double>::signaling_NaN(),
+    alpha14 = numeric_limits<double>::signaling_NaN();
 
 void PyrogenPathogenesis::init( const Parameters& parameters ){
     initPyroThres = parameters[Parameters::Y_STAR_0];
-    
-    double delt = 1.0 / n;
-    double smuY = -log(0.5) /
-        (SimTime::stepsPerYear() * parameters[Parameters::Y_STAR_HALF_LIFE]);
-    b = -smuY * delt;
-    
+    Ystar_halfLife = parameters[Parameters::Y_STAR_HALF_LIFE];
     Ystar2_13 = parameters[Parameters::Y_STAR_SQ];
-    
     //alpha: factor determining increase in pyrogenic threshold
-    double alpha14 = parameters[Parameters::ALPHA];
-    a = alpha14 * SimTime::oneTS().inDays() * delt;  
-    
+    alpha14 = parameters[Parameters::ALPHA];
     //Ystar1: critical value of parasite density in determing increase in pyrog t
     Ystar1_26 = parameters[Parameters::Y_STAR_1];
+    staticChangeTimeStep();
+}
+void PyrogenPathogenesis::staticChangeTimeStep(){
+    double delt = 1.0 / n;
+    double smuY = -log(0.5) / (SimTime::stepsPerYear() * Ystar_halfLife);
+    b = -smuY * delt;
+    a = alpha14 * SimTime::oneTS().inDays() * delt;
 }
 
 PyrogenPathogenesis::PyrogenPathogenesis(double cF) :
      PathogenesisModel (cF), _pyrogenThres (initPyroThres)
 {}
 
+void PyrogenPathogenesis::reset( double cF ){
+    PathogenesisModel::reset( cF );
+    _pyrogenThres = initPyroThres;
+}
+
 
 double PyrogenPathogenesis::getPEpisode(double timeStepMaxDensity, double totalDensity) {
     updatePyrogenThres(totalDensity);
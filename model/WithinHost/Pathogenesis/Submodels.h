@@ -39,6 +39,8 @@ public:
 
     /// Read parameters
     static void init( const Parameters& parameters );
+    /// Adjust parameters to the current time-step length
+    static void staticChangeTimeStep();
 };
 
 /// Pyrogenic threshold presentation model.
@@ -52,11 +54,14 @@ protected:
 public:
     PyrogenPathogenesis(double cF);
     virtual ~PyrogenPathogenesis() {}
+    virtual void reset( double cF );
     virtual void summarize (const Host::Human& human);
     virtual double getPEpisode(double timeStepMaxDensity, double totalDensity);
     
     /// Read parameters from XML
     static void init( const OM::Parameters& parameters );
+    /// Adjust parameters to the current time-step length
+    static void staticChangeTimeStep();
     
 protected:
     
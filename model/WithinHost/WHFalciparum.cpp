@@ -36,6 +36,7 @@
 #include "util/StreamValidator.h"
 #include "util/checkpoint_containers.h"
 #include "util/timeConversions.h"
+#include "util/MemoryStats.h"
 #include "schema/scenario.h"
 
 #include <cmath>
@@ -52,6 +53,8 @@ double WHFalciparum::sigma_i;
 double WHFalciparum::immPenalty_22;
 double WHFalciparum::asexImmRemain;
 double WHFalciparum::immEffectorRemain;
+double WHFalciparum::asexImmRemainScn;
+double WHFalciparum::immEffectorRemainScn;
 int WHFalciparum::y_lag_len = 0;
 
 // -----  static functions  -----
@@ -61,6 +64,8 @@ void WHFalciparum::init( const OM::Parameters& parameters, const scnXml::Model&
     immPenalty_22=1-exp(parameters[Parameters::IMMUNITY_PENALTY]);
     immEffectorRemain=exp(-parameters[Parameters::IMMUNE_EFFECTOR_DECAY]);
     asexImmRemain=exp(-parameters[Parameters::ASEXUAL_IMMUNITY_DECAY]);
+    immEffectorRemainScn = immEffectorRemain;
+    asexImmRemainScn = asexImmRemain;
     
     y_lag_len = SimTime::daysToSteps(20);
     
@@ -77,6 +82,21 @@ void WHFalciparum::init( const OM::Parameters& parameters, const scnXml::Model&
     }
 }
 
+void WHFalciparum::staticChangeTimeStep(){
+    // Decay over a step is that over the scenario's step, repeated. This is
+    // exact for immEffectorRemain but only approximate for asexImmRemain,
+    // whose decay depends on the level of immunity.
+    // Note: pow( x, 1.0 ) == x, thus values are restored exactly.
+    const double steps = static_cast<double>(SimTime::oneTS().inDays())
+            / sim::scenarioTS().inDays();
+    immEffectorRemain = pow( immEffectorRemainScn, steps );
+    asexImmRemain = pow( asexImmRemainScn, steps );
+    
+    y_lag_len = SimTime::daysToSteps(20);
+    
+    Pathogenesis::PathogenesisModel::staticChangeTimeStep();
+}
+
 
 // -----  Non-static  -----
 
@@ -99,6 +119,17 @@ WHFalciparum::~WHFalciparum()
 {
 }
 
+void WHFalciparum::reset( double comorbidityFactor ){
+    numInfs = 0;
+    m_cumulative_h = m_cumulative_Y = m_cumulative_Y_lag = 0.0;
+    totalDensity = timeStepMaxDensity = 0.0;
+    pathogenesisModel->reset( comorbidityFactor );
+    treatExpiryLiver = treatExpiryBlood = SimTime::never();
+    // same draw as in the constructor
+    _innateImmSurvFact = exp(-random::gauss(sigma_i));
+    m_y_lag.assign(y_lag_len, Genotypes::N(), 0.0);
+}
+
 // Infectiousness parameters: see AJTMH p.33; tau=1/sigmag**2 
 const double PTM_beta1=1.0;
 const double PTM_beta2=0.46;
@@ -217,6 +248,20 @@ Pathogenesis::StatePair WHFalciparum::determineMorbidity( Host::Human& human,
 }
 
 
+void WHFalciparum::changeTimeStep( SimTime oldTS ){
+    // m_y_lag is indexed by the start of the step on which it was written
+    const size_t oldLen = m_y_lag.internal_vec().size() / Genotypes::N();
+    vector<size_t> indices = vectors::changeTSIndices( oldLen, oldTS,
+            y_lag_len, SimTime::oneTS(), sim::latestTs0() );
+    vector2D<double> y_lag( y_lag_len, Genotypes::N(), 0.0 );
+    for( size_t i = 0; i < indices.size(); ++i ){
+        for( size_t g = 0; g < Genotypes::N(); ++g )
+            y_lag.at( i, g ) = m_y_lag.at( indices[i], g );
+    }
+    m_y_lag = y_lag;
+}
+
+
 // -----  immunity  -----
 
 void WHFalciparum::updateImmuneStatus() {
@@ -236,6 +281,12 @@ void WHFalciparum::updateImmuneStatus() {
 
 // -----  Checkpointing  -----
 
+void WHFalciparum::memoryStatsWHF( util::MemoryStats& stats ) const{
+    stats.add( "within-host immunity lag", 1, m_y_lag.heapBytes() );
+    // approximate: excludes data added by subclasses
+    stats.add( "pathogenesis model", 1, sizeof(Pathogenesis::PathogenesisModel) );
+}
+
 void WHFalciparum::checkpoint (istream& stream) {
     WHInterface::checkpoint( stream );
     _innateImmSurvFact & stream;
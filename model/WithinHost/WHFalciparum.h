@@ -49,6 +49,9 @@ public:
     //@{
     /// Initialise static parameters
     static void init( const OM::Parameters& parameters, const scnXml::Model& model );
+    
+    /// Adjust static parameters to the current time-step length
+    static void staticChangeTimeStep();
     //@}
 
     /// @brief Constructors, destructors and checkpointing functions
@@ -70,6 +73,10 @@ public:
     virtual bool treatSimple( const Host::Human& human, SimTime timeLiver, SimTime timeBlood );
     
     virtual Pathogenesis::StatePair determineMorbidity( Host::Human& human, double ageYears, bool isDoomed );
+    
+    virtual void changeTimeStep( SimTime oldTS );
+    
+    virtual void reset( double comorbidityFactor );
 
     inline double getCumulative_h() const {
         return m_cumulative_h;
@@ -127,6 +134,9 @@ protected:
     /// End of step on which treatment expires = start of first step after expiry
     SimTime treatExpiryLiver, treatExpiryBlood;
     
+    /// Add memory owned by this class (for use by memoryStats())
+    void memoryStatsWHF( util::MemoryStats& stats ) const;
+    
     virtual void checkpoint (istream& stream);
     virtual void checkpoint (ostream& stream);
 
@@ -147,6 +157,8 @@ protected:
       This variable decays the effectors m_cumulative_h and m_cumulative_Y exponentially.
     */
     static double immEffectorRemain;
+    /// Values of the above two for the scenario's time step
+    static double asexImmRemainScn, immEffectorRemainScn;
     /// Length of m_y_lag array. Wouldn't have to be dynamic if Global::interval was known at compile-time.
     /// set by initHumanParameters
     static int y_lag_len;
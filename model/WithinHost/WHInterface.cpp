@@ -82,6 +82,11 @@ void WHInterface::init( const OM::Parameters& parameters, const scnXml::Scenario
     }
 }
 
+void WHInterface::staticChangeTimeStep(){
+    // WHVivax is not supported (see ModelOptions)
+    if( !opt_vivax_simple ) WHFalciparum::staticChangeTimeStep();
+}
+
 TreatmentId WHInterface::addTreatment(const scnXml::TreatmentOption& desc){
     return Treatments::addTreatment( desc );
 }
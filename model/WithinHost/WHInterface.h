@@ -39,6 +39,9 @@ namespace OM {
 namespace Host {
     class Human;
 }
+namespace util {
+    class MemoryStats;
+}
 namespace WithinHost {
 
 /**
@@ -83,6 +86,10 @@ public:
 
     /// Create an instance using the appropriate model
     static WHInterface* createWithinHostModel( double comorbidityFactor );
+    
+    /** Adjust static parameters after a change of time-step length (model
+     * option COARSE_WARMUP). */
+    static void staticChangeTimeStep();
     //@}
 
     /// @brief Constructors, destructors and checkpointing functions
@@ -122,6 +129,9 @@ public:
     
     /// @returns true if host has patent parasites
     virtual bool summarize(const Host::Human& human) const =0;
+    
+    /// Add memory used by this model and its infections and drugs
+    virtual void memoryStats( util::MemoryStats& stats ) const =0;
 
     /// Create a new infection within this human
     virtual void importInfection() =0;
@@ -193,6 +203,15 @@ public:
     /// Special intervention: clears all immunity
     virtual void clearImmunity() =0;
     
+    /** Convert state stored per time step after the time-step length changed
+     * from oldTS to SimTime::oneTS(). Call between updates. */
+    virtual void changeTimeStep( SimTime oldTS ){}
+    
+    /** Return to the state of a newly created model, for reuse by a newborn
+     * human (see Population). Random numbers are drawn as by the
+     * constructor, and container capacity is kept. */
+    virtual void reset( double comorbidityFactor ) =0;
+    
     // TODO(monitoring): these shouldn't have to be exposed (perhaps use summarize to report the data):
     virtual double getCumulative_h() const =0;
     virtual double getCumulative_Y() const =0;
@@ -28,6 +28,7 @@
 #include "util/checkpoint_containers.h"
 #include "util/timeConversions.h"
 #include "util/CommandLine.h"
+#include "util/MemoryStats.h"
 #include <schema/scenario.h>
 #include <algorithm>
 #include <limits>
@@ -88,6 +89,7 @@ void initNHypnozoites(){
         total += pow( baseNumberHypnozoites, n );
     
     double cumP = 0.0;
+    nHypnozoitesProbMap.clear();
     for( int n = 0; n <= maxNumberHypnozoites; ++n ){
         cumP += pow( baseNumberHypnozoites, n ) / total;
         // pair n with the cumulative probability of sampling n:
@@ -251,6 +253,12 @@ VivaxBrood::UpdResult VivaxBrood::update(){
     return result;
 }
 
+SimTime VivaxBrood::nextEventDate() const{
+    SimTime next = releaseDates.empty() ? SimTime::future() : releaseDates.back();
+    if( isPatent() ) next = min( next, bloodStageClearDate );
+    return next;
+}
+
 void VivaxBrood::treatmentBS(){
     // Blood stage treatment: clear both asexual and sexual parasites from the
     // blood. NOTE: we assume infections removed via treatment do not leave
@@ -277,6 +285,7 @@ void VivaxBrood::treatmentLS(){
 // ———  per-host code  ———
 
 WHVivax::WHVivax( double comorbidityFactor ) :
+    nextBroodEvent(SimTime::never()),
     cumPrimInf(0),
     pEvent( numeric_limits<double>::quiet_NaN() ),
     pFirstRelapseEvent( numeric_limits<double>::quiet_NaN() ),
@@ -294,6 +303,20 @@ WHVivax::WHVivax( double comorbidityFactor ) :
     noPQ = ( pHetNoPQ > 0.0 && random::bernoulli(pHetNoPQ) );
 }
 
+void WHVivax::reset( double comorbidityFactor ){
+    assert( comorbidityFactor == 1.0 );        // checked by constructor
+    numInfs = 0;
+    infections.clear();
+    nextBroodEvent = SimTime::never();
+    morbidity = Pathogenesis::NONE;
+    cumPrimInf = 0;
+    treatExpiryLiver = treatExpiryBlood = SimTime::never();
+    pEvent = numeric_limits<double>::quiet_NaN();
+    pFirstRelapseEvent = numeric_limits<double>::quiet_NaN();
+    pSevere = 0.0;
+    noPQ = ( pHetNoPQ > 0.0 && random::bernoulli(pHetNoPQ) );
+}
+
 WHVivax::~WHVivax(){
 #ifdef WHVivaxSamples
     if( this == sampleHost ){
@@ -338,9 +361,18 @@ bool WHVivax::summarize(const Host::Human& human) const{
     return patentHost;
 }
 
+void WHVivax::memoryStats( util::MemoryStats& stats )const{
+    stats.add( "within-host model (vivax)", 1, sizeof(*this) );
+    foreach( const VivaxBrood& brood, infections ){
+        stats.add( "infection (vivax brood)", 1,
+                brood.memoryBytes() + util::MemoryStats::LIST_NODE );
+    }
+}
+
 void WHVivax::importInfection(){
     // this means one new liver stage infection, which can result in multiple blood stages
     infections.push_back( VivaxBrood( this ) );
+    nextBroodEvent = SimTime::never();
 }
 
 void WHVivax::update(int nNewInfs, vector<double>&,
@@ -361,7 +393,13 @@ void WHVivax::update(int nNewInfs, vector<double>&,
     double oldpEvent = ( isnan(pEvent))? 1.0 : pEvent;
     // always use the first relapse probability for following relapses as a factor
     double oldpRelapseEvent = ( isnan(pFirstRelapseEvent))? 1.0 : pFirstRelapseEvent;
-    list<VivaxBrood>::iterator inf = infections.begin();
+    
+    // Nothing can happen to any brood before nextBroodEvent unless there are
+    // new broods or treatment, so we can skip looking at them.
+    bool updateBroods = nNewInfs > 0 || treatmentLiver || treatmentBlood ||
+        nextBroodEvent <= sim::ts0();
+    if( updateBroods ) nextBroodEvent = SimTime::future();
+    list<VivaxBrood>::iterator inf = updateBroods ? infections.begin() : infections.end();
     while( inf != infections.end() ){
         if( treatmentLiver ) inf->treatmentLS();
         if( treatmentBlood ) inf->treatmentBS();        // clearnace due to treatment; no protection against reemergence
@@ -406,7 +444,10 @@ void WHVivax::update(int nNewInfs, vector<double>&,
         }
         
         if( result.isFinished ) inf = infections.erase( inf );
-        else ++inf;
+        else{
+            nextBroodEvent = min( nextBroodEvent, inf->nextEventDate() );
+            ++inf;
+        }
     }
     
     //TODO were pEvent and pFirstRelapseEvent meant to get updated?
@@ -458,6 +499,7 @@ void WHVivax::optionalPqTreatment( const Host::Human& human ){
             for( list<VivaxBrood>::iterator it = infections.begin(); it != infections.end(); ++it ){
                 it->treatmentLS();
             }
+            nextBroodEvent = SimTime::never();
         }
         mon::reportEventMHI( mon::MHT_LS_TREATMENTS, human, 1 );
     }
@@ -481,6 +523,7 @@ bool WHVivax::treatSimple( const Host::Human& human, SimTime timeLiver, SimTime
                 for( list<VivaxBrood>::iterator it = infections.begin(); it != infections.end(); ++it ){
                     it->treatmentLS();
                 }
+                nextBroodEvent = SimTime::never();
             }
         }
         mon::reportEventMHI( mon::MHT_LS_TREATMENTS, human, 1 );
@@ -493,6 +536,7 @@ bool WHVivax::treatSimple( const Host::Human& human, SimTime timeLiver, SimTime
             for( list<VivaxBrood>::iterator it = infections.begin(); it != infections.end(); ++it ){
                 it->treatmentBS();
             }
+            nextBroodEvent = SimTime::never();
         }else{
             treatExpiryBlood = max( treatExpiryBlood, sim::nowOrTs1() + timeBlood );
         }
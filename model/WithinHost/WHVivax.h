@@ -90,12 +90,22 @@ public:
         return bloodStageClearDate > sim::latestTs0();
     }
     
+    /** The first time step on which update() may have an effect: the next
+     * hypnozoite release or the end of the blood stage, whichever is first.
+     * SimTime::future() if there is neither. */
+    SimTime nextEventDate() const;
+    
     /** Fully clear blood stage parasites. */
     void treatmentBS();
     
     /** Fully clear liver stage parasites. */
     void treatmentLS();
     
+    /// Memory used by this brood, in bytes (excluding list overhead)
+    inline size_t memoryBytes() const{
+        return sizeof(*this) + releaseDates.capacity() * sizeof(SimTime);
+    }
+    
 private:
     VivaxBrood() {}     // not default constructible
     
@@ -146,10 +156,13 @@ public:
     virtual ~WHVivax();
     //@}
     
+    virtual void reset( double comorbidityFactor );
+    
     virtual double probTransmissionToMosquito( double tbvFactor, double *sumX )const;
     virtual double pTransGenotype( double pTrans, double sumX, size_t genotype );
     
     virtual bool summarize(const Host::Human& human) const;
+    virtual void memoryStats( util::MemoryStats& stats ) const;
     
     virtual void importInfection();
     
@@ -181,6 +194,14 @@ private:
     
     list<VivaxBrood> infections;
     
+    /* Earliest VivaxBrood::nextEventDate() of all infections: until then
+     * update() need not touch the broods (most are dormant hypnozoites).
+     * SimTime::never() forces the broods to be updated on the next step; this
+     * is used whenever broods are added or modified outside of update().
+     * Not checkpointed (we just update all broods on the first step after a
+     * load). */
+    SimTime nextBroodEvent;
+    
     /* Is flagged as never getting PQ: this is a heteogeneity factor. Example:
      * Set to zero if everyone can get PQ, 0.5 if females can't get PQ and
      * males aren't tested (i.e. all can get it) or (1+p)/2 where p is the
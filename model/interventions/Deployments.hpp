@@ -28,6 +28,7 @@
 #include "Population.h"
 #include "Transmission/TransmissionModel.h"
 #include "util/random.h"
+#include "util/ModelOptions.h"
 #include <schema/interventions.h>
 
 namespace OM { namespace interventions {
@@ -188,14 +189,17 @@ protected:
      * @param subPop Either ComponentId_pop or a sub-population to which deployment is restricted
      * @param complement Whether to take the complement of the sub-population
      *  to which deployment will be restricted
+     * @param salt Salt for random sub-streams, identifying the deployment
+     *  element (see InterventionManager::init)
      */
     HumanDeploymentBase( const scnXml::DeploymentBase& deploy,
                          const HumanIntervention* intervention,
-                         ComponentId subPop, bool complement ) :
+                         ComponentId subPop, bool complement, uint32_t salt ) :
             coverage( deploy.getCoverage() ),
             subPop( subPop ),
             complement( complement ),
-            intervention( intervention )
+            intervention( intervention ),
+            salt( salt )
     {
         if( !(coverage >= 0.0 && coverage <= 1.0) ){
             throw util::xml_scenario_error("intervention deployment coverage must be in range [0,1]");
@@ -212,6 +216,7 @@ protected:
     ComponentId subPop;      // ComponentId_pop if deployment is not restricted to a sub-population
     bool complement;
     const HumanIntervention *intervention;
+    uint32_t salt;      // identifies the deployment element (salts random sub-streams)
 };
 
 /// Timed deployment of human-specific interventions
@@ -223,13 +228,14 @@ public:
      * (proportion of eligible individuals who receive the intervention).
      * @param intervention The HumanIntervention to deploy.
      * @param subPop Either ComponentId_pop or a sub-population to which deployment is restricted
+     * @param salt Salt for random sub-streams
      */
     TimedHumanDeployment( SimTime date,
                            const scnXml::MassDeployment& mass,
                            const HumanIntervention* intervention,
-                           ComponentId subPop, bool complement ) :
+                           ComponentId subPop, bool complement, uint32_t salt ) :
         TimedDeployment( date ),
-        HumanDeploymentBase( mass, intervention, subPop, complement ),
+        HumanDeploymentBase( mass, intervention, subPop, complement, salt ),
         minAge( SimTime::fromYearsN( mass.getMinAge() ) ),
         maxAge( SimTime::future() )
     {
@@ -242,11 +248,14 @@ public:
     }
     
     virtual void deploy (OM::Population& population) {
+        util::random::BernoulliSequence select( coverage,
+                util::ModelOptions::option( util::GEOMETRIC_SKIP_SAMPLING ) );
         for(Population::Iter iter = population.begin(); iter != population.end(); ++iter) {
             SimTime age = iter->age(sim::now());
             if( age >= minAge && age < maxAge ){
                 if( subPop == interventions::ComponentId_pop || (iter->isInSubPop( subPop ) != complement) ){
-                    if( util::random::bernoulli( coverage ) ){
+                    util::random::SubStream stream( util::random::DEPLOYMENT, iter->getID(), salt );
+                    if( select.next() ){
                         deployToHuman( *iter, mon::Deploy::TIMED );
                     }
                 }
@@ -280,13 +289,14 @@ public:
      * @param intervention The HumanIntervention to deploy.
      * @param subPop Either ComponentId_pop or a sub-population to which deployment is restricted
      * @param cumCuvId Id of component to test coverage for
+     * @param salt Salt for random sub-streams
      */
     TimedCumulativeHumanDeployment( SimTime date,
                            const scnXml::MassDeployment& mass,
                            const HumanIntervention* intervention,
                            ComponentId subPop, bool complement,
-                           ComponentId cumCuvId ) :
-        TimedHumanDeployment( date, mass, intervention, subPop, complement ),
+                           ComponentId cumCuvId, uint32_t salt ) :
+        TimedHumanDeployment( date, mass, intervention, subPop, complement, salt ),
         cumCovInd( cumCuvId )
     {
     }
@@ -314,10 +324,13 @@ public:
             // selected from the list unprotected.
             double additionalCoverage = (coverage - propProtected) / (1.0 - propProtected);
             cerr << "cum deployment: prop protected " << propProtected << "; additionalCoverage " << additionalCoverage << "; total " << total << endl;
+            util::random::BernoulliSequence select( additionalCoverage,
+                    util::ModelOptions::option( util::GEOMETRIC_SKIP_SAMPLING ) );
             for(vector<Host::Human*>::iterator iter = unprotected.begin();
                  iter != unprotected.end(); ++iter)
             {
-                if( util::random::uniform_01() < additionalCoverage ){
+                util::random::SubStream stream( util::random::DEPLOYMENT, (*iter)->getID(), salt );
+                if( select.next() ){
                     deployToHuman( **iter, mon::Deploy::TIMED );
                 }
             }
@@ -375,8 +388,8 @@ public:
     ContinuousHumanDeployment( SimTime begin, SimTime end,
                                  const ::scnXml::ContinuousDeployment& elt,
                                  const HumanIntervention* intervention,
-                                 ComponentId subPop, bool complement ) :
-            HumanDeploymentBase( elt, intervention, subPop, complement ),
+                                 ComponentId subPop, bool complement, uint32_t salt ) :
+            HumanDeploymentBase( elt, intervention, subPop, complement, salt ),
             begin( begin ), end( end ),
             deployAge( SimTime::fromYearsN( elt.getTargetAgeYrs() ) )
     {
@@ -414,6 +427,7 @@ public:
             // human for now because remaining ones happen in the future
             return false;
         }else if( deployAge == age ){
+            util::random::SubStream stream( util::random::DEPLOYMENT, human.getID(), salt );
             if( begin <= sim::intervNow() && sim::intervNow() < end &&
                 ( subPop == interventions::ComponentId_pop ||
                     (human.isInSubPop( subPop ) != complement)
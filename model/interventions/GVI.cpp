@@ -22,6 +22,7 @@
 #include "interventions/GVI.h"
 #include "Host/Human.h"
 #include "util/SpeciesIndexChecker.h"
+#include "util/MemoryStats.h"
 #include "util/errors.h"
 #include <cmath>
 
@@ -139,6 +140,11 @@ double HumanGVI::relFecundity(size_t speciesIndex) const{
     return anoph.byProtection( effect );
 }
 
+void HumanGVI::memoryStats( util::MemoryStats& stats ) const{
+    stats.add( "intervention component (GVI)", 1,
+               sizeof(*this) + util::MemoryStats::LIST_NODE );
+}
+
 void HumanGVI::checkpoint( ostream& stream ){
     deployTime & stream;
     decayHet & stream;
@@ -29,6 +29,9 @@ namespace OM {
 namespace Host {
     class Human;
 }
+namespace util {
+    class MemoryStats;
+}
 namespace interventions {
     class VaccineComponent;
 
@@ -103,10 +106,17 @@ private:
 /** Per-human vaccine code. */
 class PerHumanVaccine {
 public:
-    PerHumanVaccine() {}
+    PerHumanVaccine() : factorsTime(SimTime::never()) {}
     
-    /** Get one minus the efficacy of the vaccine (1 for no effect, 0 for full effect). */
-    double getFactor( Vaccine::Types type )const;
+    /** Get one minus the efficacy of the vaccine (1 for no effect, 0 for full effect).
+     * 
+     * Factors for all types are computed together and cached for the time
+     * step, since each is requested (at least) once per step. */
+    inline double getFactor( Vaccine::Types type )const{
+        if( effects.empty() ) return 1.0;
+        if( factorsTime != sim::ts1() ) updateFactors();
+        return factors[type];
+    }
     
     /** Vaccinate unless the passed VaccineLimits specify not to.
      * 
@@ -123,6 +133,15 @@ public:
     }
 #endif
     
+    /// Add heap memory used by this object to stats
+    void memoryStats( util::MemoryStats& stats ) const;
+    
+    /// Remove all vaccine effects, as for a new human
+    inline void reset(){
+        effects.clear();
+        factorsTime = SimTime::never();
+    }
+    
     /// Checkpointing
     template<class S>
     void operator& (S& stream) {
@@ -133,6 +152,14 @@ private:
     /// Details for each deployed vaccine for this human
     typedef std::vector<PerEffectPerHumanVaccine> EffectList;
     EffectList effects;
+    
+    /// Compute factors for the current time step
+    void updateFactors()const;
+    
+    // Cache of getFactor() results, valid when factorsTime == sim::ts1().
+    // Not checkpointed (recomputed on first use).
+    mutable SimTime factorsTime;
+    mutable double factors[Vaccine::NumVaccineTypes];
 };
 
 }
@@ -24,6 +24,7 @@
 #include "util/random.h"
 #include "util/errors.h"
 #include "util/SpeciesIndexChecker.h"
+#include "util/MemoryStats.h"
 
 #include "R_nmath/qnorm.h"
 #include <cmath>
@@ -284,6 +285,11 @@ double HumanIRS::relFecundity(size_t speciesIndex) const{
     return anoph.byProtection( effect );
 }
 
+void HumanIRS::memoryStats( util::MemoryStats& stats ) const{
+    stats.add( "intervention component (IRS)", 1,
+               sizeof(*this) + util::MemoryStats::LIST_NODE );
+}
+
 void HumanIRS::checkpoint( ostream& stream ){
     deployTime & stream;
     initialInsecticide & stream;
@@ -186,6 +186,8 @@ public:
     /// Get the mosquito fecundity multiplier (1 for no effect).
     virtual double relFecundity(size_t speciesIndex) const;
     
+    virtual void memoryStats( util::MemoryStats& stats ) const;
+    
 protected:
     virtual void checkpoint( ostream& stream );
     
@@ -22,6 +22,7 @@
 #include "util/random.h"
 #include "util/errors.h"
 #include "util/SpeciesIndexChecker.h"
+#include "util/MemoryStats.h"
 #include "Host/Human.h"
 #include "R_nmath/qnorm.h"
 #include <cmath>
@@ -640,7 +641,9 @@ void ITNComponent::ITNAnopheles::init(
 HumanITN::HumanITN( const ITNComponent& params ) :
         PerHostInterventionData( params.id() ),
         nHoles( 0 ),
-        holeIndex( 0.0 )
+        holeIndex( 0.0 ),
+        insecticideTime( SimTime::never() ),
+        insecticideContent( 0.0 )
 {
     // Net rips and insecticide loss are assumed to co-vary dependent on
     // handling of net. They are sampled once per human: human handling is
@@ -665,6 +668,7 @@ void HumanITN::redeploy(const OM::Transmission::HumanVectorInterventionComponent
     
     deployTime = sim::nowOrTs1();
     disposalTime = sim::nowOrTs1() + params.attritionOfNets->sampleAgeOfDecay();
+    insecticideTime = SimTime::never();
     nHoles = 0;
     holeIndex = 0.0;
     // this is sampled independently: initial insecticide content doesn't depend on handling
@@ -718,6 +722,11 @@ double HumanITN::relFecundity(size_t speciesIndex) const{
     return anoph.relFecundity( holeIndex, getInsecticideContent(params) );
 }
 
+void HumanITN::memoryStats( util::MemoryStats& stats ) const{
+    stats.add( "intervention component (ITN)", 1,
+               sizeof(*this) + util::MemoryStats::LIST_NODE );
+}
+
 void HumanITN::checkpoint( ostream& stream ){
     deployTime & stream;
     disposalTime & stream;
@@ -728,7 +737,10 @@ void HumanITN::checkpoint( ostream& stream ){
     ripRate & stream;
     insecticideDecayHet & stream;
 }
-HumanITN::HumanITN( istream& stream, ComponentId id ) : PerHostInterventionData( id )
+HumanITN::HumanITN( istream& stream, ComponentId id ) :
+        PerHostInterventionData( id ),
+        insecticideTime( SimTime::never() ),
+        insecticideContent( 0.0 )
 {
     deployTime & stream;
     disposalTime & stream;
@@ -238,10 +238,15 @@ public:
         return holeIndex;
     }
     inline double getInsecticideContent(const ITNComponent& params)const{
+        // This is used by each effect for each species, so cache per time step
+        if( insecticideTime != sim::nowOrTs1() ){
             SimTime age = sim::nowOrTs1() - deployTime;  // implies age 1 TS on first use
-        double effectSurvival = params.insecticideDecay->eval( age,
+            double effectSurvival = params.insecticideDecay->eval( age,
                                               insecticideDecayHet );
-        return initialInsecticide * effectSurvival;
+            insecticideContent = initialInsecticide * effectSurvival;
+            insecticideTime = sim::nowOrTs1();
+        }
+        return insecticideContent;
     }
     
     /// Call once per time step to update holes
@@ -258,6 +263,8 @@ public:
     /// Get the mosquito fecundity multiplier (1 for no effect).
     virtual double relFecundity(size_t speciesIndex) const;
     
+    virtual void memoryStats( util::MemoryStats& stats ) const;
+    
 protected:
     virtual void checkpoint( ostream& stream );
     
@@ -272,6 +279,11 @@ private:
     double holeRate;	// rate at which new holes are created (holes/time-step)
     double ripRate;		// rate at which holes are enlarged (rips/hole/time-step)
     DecayFuncHet insecticideDecayHet;
+    
+    // Cache of getInsecticideContent(), valid when insecticideTime equals
+    // sim::nowOrTs1(). Not checkpointed.
+    mutable SimTime insecticideTime;
+    mutable double insecticideContent;
 };
 
 } }
@@ -50,6 +50,24 @@ vector<ComponentId> removeAtIds[SubPopRemove::NUM];
 
 // static functions:
 
+/* Salt for the random sub-streams of a deployment element: a hash (FNV-1a)
+ * of the identifiers of the components it deploys, so that it does not
+ * change when other interventions are added to or removed from a scenario.
+ * Elements deploying the same components are distinguished by their order
+ * (uses counts previous uses of each hash). */
+uint32_t deploymentSalt( const scnXml::Deployment& elt, map<uint32_t,uint32_t>& uses ){
+    uint32_t hash = 2166136261u;
+    for( xsd::cxx::tree::sequence<scnXml::Component>::const_iterator cp =
+        elt.getComponent().begin(), cpEnd = elt.getComponent().end(); cp != cpEnd; ++cp )
+    {
+        const string& id = cp->getId();
+        for( size_t i = 0; i <= id.size(); ++i ){   // includes the terminating 0
+            hash = (hash ^ static_cast<uint8_t>( id.c_str()[i] )) * 16777619u;
+        }
+    }
+    return hash + uses[hash]++;
+}
+
 void InterventionManager::init (const scnXml::Interventions& intervElt){
     nextTimed = 0;
     
@@ -162,6 +180,7 @@ void InterventionManager::init (const scnXml::Interventions& intervElt){
         }
         
         // 2. Read the list of deployments
+        map<uint32_t,uint32_t> saltUses;
         for( scnXml::HumanInterventions::DeploymentConstIterator it =
                 human.getDeployment().begin(),
                 end = human.getDeployment().end(); it != end; ++it )
@@ -170,6 +189,7 @@ void InterventionManager::init (const scnXml::Interventions& intervElt){
             // 2.a intervention components
             HumanIntervention *intervention = new HumanIntervention( elt.getComponent(),
                 elt.getCondition() );
+            const uint32_t salt = deploymentSalt( elt, saltUses );
             
             // 2.b intervention deployments
             for( scnXml::Deployment::ContinuousConstIterator ctsIt = elt.getContinuous().begin();
@@ -198,7 +218,8 @@ void InterventionManager::init (const scnXml::Interventions& intervElt){
                                                       UnitParse::STEPS /*STEPS is only for backwards compatibility*/);
                         }
                         continuous.push_back( new ContinuousHumanDeployment(
-                            begin, end, *it2, intervention, subPop, complement ) );
+                            begin, end, *it2, intervention, subPop, complement,
+                            salt ) );
                     }catch( const util::format_error& e ){
                         throw util::xml_scenario_error(
                             string("interventions/human/deployment/continuous/deploy: ")
@@ -267,13 +288,13 @@ void InterventionManager::init (const scnXml::Interventions& intervElt){
                         for( multimap<SimTime, const scnXml::MassDeployment*>::const_iterator deploy =
                             deployTimes.begin(), end = deployTimes.end(); deploy != end; ++deploy )
                         {
-                            timed.push_back( new TimedCumulativeHumanDeployment( deploy->first, *deploy->second, intervention, subPop, complement, cumCovComponent ) );
+                            timed.push_back( new TimedCumulativeHumanDeployment( deploy->first, *deploy->second, intervention, subPop, complement, cumCovComponent, salt ) );
                         }
                     }else{
                         for( multimap<SimTime, const scnXml::MassDeployment*>::const_iterator deploy =
                             deployTimes.begin(), end = deployTimes.end(); deploy != end; ++deploy )
                         {
-                            timed.push_back( new TimedHumanDeployment( deploy->first, *deploy->second, intervention, subPop, complement ) );
+                            timed.push_back( new TimedHumanDeployment( deploy->first, *deploy->second, intervention, subPop, complement, salt ) );
                         }
                     }
                 }catch( const util::format_error& e ){
@@ -391,6 +412,21 @@ void InterventionManager::init (const scnXml::Interventions& intervElt){
 #endif
 }
 
+void InterventionManager::clear(){
+    // deployments refer to interventions, which refer to components
+    timed.clear();
+    continuous.clear();
+    nextTimed = 0;
+    humanInterventions.clear();
+    humanComponents.clear();
+    identifierMap.clear();
+    VaccineComponent::clear();
+    for( size_t i = 0; i < SubPopRemove::NUM; ++i ){
+        removeAtIds[i].clear();
+    }
+    importedInfections = Host::ImportedInfections();
+}
+
 ComponentId InterventionManager::getComponentId( const string textId )
 {
     map<string,ComponentId>::const_iterator it = identifierMap.find( textId );
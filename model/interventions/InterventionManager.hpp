@@ -44,6 +44,9 @@ public:
     /** Read XML descriptions. */
     static void init(const scnXml::Interventions& intervElt);
     
+    /** Free all interventions, returning to the state before init(). */
+    static void clear();
+    
     /// Checkpointing
     template<class S>
     static void checkpoint (S& stream) {
@@ -76,6 +79,11 @@ public:
         return humanComponents[id.id];
     }
     
+    /// Number of components (ComponentId values are less than this)
+    inline static size_t numComponents(){
+        return humanComponents.size();
+    }
+    
     /** Get a numeric ComponentId from the textual identifier used in the XML.
      * 
      * If textId is unknown, an xml_scenario_error is thrown. */
@@ -26,6 +26,7 @@
 #include "util/ModelOptions.h"
 #include "schema/interventions.h"
 #include "util/StreamValidator.h"
+#include "util/MemoryStats.h"
 
 #include <limits>
 #include <cmath>
@@ -61,6 +62,11 @@ VaccineComponent::VaccineComponent( ComponentId component, const scnXml::Vaccine
     params[component.id] = this;
 }
 
+void VaccineComponent::clear(){
+    params.clear();
+    reportComponent = ComponentId_pop;
+}
+
 void VaccineComponent::deploy(Host::Human& human, mon::Deploy::Method method, VaccineLimits vaccLimits) const
 {
     bool administered = human.getVaccine().possiblyVaccinate( human, id(), vaccLimits );
@@ -139,17 +145,20 @@ PerEffectPerHumanVaccine::PerEffectPerHumanVaccine( ComponentId id, const Vaccin
     hetSample = params.decayFunc->hetSample();
 }
 
-double PerHumanVaccine::getFactor( Vaccine::Types type ) const{
-    double factor = 1.0;
+void PerHumanVaccine::memoryStats( util::MemoryStats& stats ) const{
+    stats.add( "vaccine effects", effects.size(), util::MemoryStats::bytes( effects ) );
+}
+
+void PerHumanVaccine::updateFactors() const{
+    for( size_t type = 0; type < Vaccine::NumVaccineTypes; ++type )
+        factors[type] = 1.0;
     for( EffectList::const_iterator effect = effects.begin(); effect != effects.end(); ++effect ){
-        if( VaccineComponent::getParams(effect->component).type == type ){
-            SimTime age = sim::ts1() - effect->timeLastDeployment;  // implies age 1 TS on first use
-            double decayFactor = VaccineComponent::getParams(effect->component)
-                .decayFunc->eval( age, effect->hetSample );
-            factor *= 1.0 - effect->initialEfficacy * decayFactor;
-        }
+        const VaccineComponent& params = VaccineComponent::getParams(effect->component);
+        SimTime age = sim::ts1() - effect->timeLastDeployment;  // implies age 1 TS on first use
+        double decayFactor = params.decayFunc->eval( age, effect->hetSample );
+        factors[params.type] *= 1.0 - effect->initialEfficacy * decayFactor;
     }
-    return factor;
+    factorsTime = sim::ts1();
 }
 
 bool PerHumanVaccine::possiblyVaccinate( const Host::Human& human,
@@ -180,6 +189,7 @@ bool PerHumanVaccine::possiblyVaccinate( const Host::Human& human,
     
     effect->numDosesAdministered = numDosesAdministered + 1;
     effect->timeLastDeployment = sim::nowOrTs1();
+    factorsTime = SimTime::never();     // invalidate cache
     
     return true;
 }
@@ -46,6 +46,9 @@ public:
     
     virtual Component::Type componentType() const;
     
+    /// Forget all vaccine components (called when components are freed)
+    static void clear();
+    
 #ifdef WITHOUT_BOINC
     virtual void print_details( std::ostream& out )const;
 #endif
@@ -68,6 +68,13 @@ SimTime nextSurveyTime();
  * infantAllCauseMortality (survey 21) output. */
 SimTime finalSurveyTime();
 
+/** Return the time of reported survey n (numbered from 1 as in output), or
+ * SimTime::never() if there is no such survey. */
+SimTime reportedSurveyTime( size_t n );
+
+/// The number of reported surveys
+inline size_t numReportedSurveys(){ return impl::nSurveys; }
+
 /// The number of cohort sets
 inline size_t numCohortSets(){ return impl::nCohorts; }
 
@@ -22,6 +22,8 @@
 #define H_OM_mon_management
 
 #include <fstream>
+#include <vector>
+#include <stdint.h>
 
 namespace scnXml{
     class Scenario;
@@ -33,6 +35,9 @@ namespace scnXml{
  * It does not store reported data (directly) and does not handle reports. */
 namespace OM {
     class Parameters;
+namespace util {
+    class MemoryStats;
+}
 namespace mon {
 
 /// Read survey times from XML.
@@ -46,12 +51,91 @@ void initCohorts( const scnXml::Monitoring& monitoring );
 /// Call just before the start of the intervention period
 void initMainSim();
 
+/// Forget configuration and reported data, returning to the state before
+/// initSurveyTimes (so that another simulation can be set up)
+void clear();
+
 /// Call after all data for some survey number has been provided
 void concludeSurvey();
 
-/// Write survey data to output.txt (or configured file)
+/// Write survey data to output.txt (or configured file), and to the binary
+/// output file if one was requested
 void writeSurveyData();
 
+/** Survey results as fixed-width typed columns, one entry per output
+ * record. Identifiers are as in the output file: surveys, age groups, species
+ * and drugs are numbered from 1 (0 where not applicable). */
+struct SurveyColumns {
+    template<typename T>
+    void put( int survey, size_t ageGroup, uint32_t cohortSet, size_t species,
+              size_t genotype, size_t drug, int measure, T value )
+    {
+        surveys.push_back( survey );
+        ageGroups.push_back( ageGroup );
+        cohortSets.push_back( cohortSet );
+        speciesIds.push_back( species );
+        genotypes.push_back( genotype );
+        drugs.push_back( drug );
+        measures.push_back( measure );
+        values.push_back( value );
+    }
+    
+    inline size_t rows() const{ return values.size(); }
+    
+    std::vector<uint32_t> surveys, ageGroups, cohortSets, speciesIds, genotypes, drugs;
+    std::vector<int32_t> measures;
+    std::vector<double> values;
+};
+
+/** Replace the contents of columns with all survey data collected so far
+ * (the records writeSurveyData() would write). Surveys not yet concluded
+ * have zero values. */
+void collectSurveyData( SurveyColumns& columns );
+
+/** Reports made by one thread, to be stored later in a fixed order.
+ *
+ * While a buffer is set for a thread (setReportBuffer()), reports made by
+ * that thread are appended to it instead of being stored. This lets several
+ * threads collect survey data; replaying the buffers in population order
+ * gives exactly the results of serial collection. */
+class ReportBuffer {
+public:
+    /// Append a report (see Store::report() and Store::deploy() in mon.cpp)
+    inline void add( uint8_t type, double value, int measure, size_t survey,
+            size_t ageIndex, uint32_t cohortSet, size_t species,
+            size_t genotype, size_t drug )
+    {
+        Record r = { value, static_cast<uint32_t>(survey),
+            static_cast<uint32_t>(ageIndex), cohortSet,
+            static_cast<uint32_t>(species), static_cast<uint32_t>(genotype),
+            static_cast<uint32_t>(drug), static_cast<uint16_t>(measure), type };
+        records.push_back( r );
+    }
+    
+    /// Number of reports buffered
+    inline size_t size() const{ return records.size(); }
+    
+    /// Store reports with indices in [begin, end), in order. Call with no
+    /// buffer set for the calling thread.
+    void replay( size_t begin, size_t end ) const;
+    
+private:
+    struct Record {
+        double value;
+        uint32_t survey, ageIndex, cohortSet, species, genotype, drug;
+        uint16_t measure;
+        uint8_t type;
+    };
+    std::vector<Record> records;
+};
+
+/** Set the buffer for reports made by the calling thread, or pass 0 to store
+ * reports directly (the default). */
+void setReportBuffer( ReportBuffer* buffer );
+
+/// Add memory used by stored reports to stats
+void memoryStats( util::MemoryStats& stats );
+
 // Checkpointing
 void checkpoint( std::ostream& stream );
 void checkpoint( std::istream& stream );
@@ -60,10 +144,18 @@ void checkpoint( std::istream& stream );
 namespace internal{
     /// Call before start of simulation to set up outputs. Call initSurveyTimes first.
     void initReporting( const scnXml::Scenario& scenario );
+    /// Undo initReporting (see mon::clear())
+    void clearReporting();
     
     // Write results to stream
     void write( std::ostream& stream );
     
+    /** Write results to stream in the binary columnar format: a header
+     * ("OMBO" byte-order mark, format version, column and row counts and a
+     * name, type code and width for each column) followed by the data of
+     * each column in turn. util/readOutput.py can read this. */
+    void writeBinary( std::ostream& stream );
+    
     /** Get the output cohort set numeric identifier given the internal one
      * (as returned by Survey::updateCohortSet()). */
     uint32_t cohortSetOutputId( uint32_t cohortSet );
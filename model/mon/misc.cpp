@@ -178,6 +178,13 @@ SimTime nextSurveyTime(){
 SimTime finalSurveyTime(){
     return impl::surveyTimes[impl::surveyTimes.size()-1].time;
 }
+SimTime reportedSurveyTime( size_t n ){
+    for( size_t i = 0; i < impl::surveyTimes.size(); ++i ){
+        const SurveyTime& survTime = impl::surveyTimes[i];
+        if( survTime.isReported() && survTime.num + 1 == n ) return survTime.time;
+    }
+    return SimTime::never();
+}
 
 void writeSurveyData ()
 {
@@ -205,6 +212,14 @@ void writeSurveyData ()
     internal::write( outputFile );
     
     outputFile.close();
+    
+    string binary_name = util::CommandLine::getBinaryOutputName();
+    if( !binary_name.empty() ){
+        ofstream binaryFile( util::BoincWrapper::resolveFile( binary_name ).c_str(),
+                             std::ios::out | std::ios::binary );
+        internal::writeBinary( binaryFile );
+        binaryFile.close();
+    }
 }
 
 
@@ -274,6 +289,15 @@ void initCohorts( const scnXml::Monitoring& monitoring )
     }
 }
 
+void clear(){
+    internal::clearReporting();
+    impl::surveyTimes.clear();
+    impl::nSurveys = 0;
+    impl::nCohorts = 1;
+    cohortSubPopNumbers.clear();
+    cohortSubPopIds.clear();
+}
+
 uint32_t updateCohortSet( uint32_t old, ComponentId subPop, bool isMember ){
     map<ComponentId,uint32_t>::const_iterator it = cohortSubPopIds.find( subPop );
     if( it == cohortSubPopIds.end() ) return old;       // sub-pop not used in cohorts
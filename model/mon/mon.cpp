@@ -28,11 +28,15 @@
 #include "Clinical/CaseManagementCommon.h"
 #include "Host/Human.h"
 #include "util/errors.h"
+#include "util/checkpoint_containers.h"
+#include "util/MemoryStats.h"
 #include "schema/scenario.h"
 
 #include <typeinfo>
+#include <cstring>
 #include <iostream>
 #include <boost/format.hpp>
+#include <boost/unordered_map.hpp>
 
 namespace OM {
 namespace mon {
@@ -56,6 +60,76 @@ namespace impl {
     SimTime nextSurveyTime = SimTime::future();
     
     vector<Condition> conditions;
+    
+    // If set, reports made by this thread are buffered here (see
+    // setReportBuffer()) instead of being stored.
+    thread_local ReportBuffer* reportBuffer = 0;
+    // Type codes of buffered reports
+    enum BufferedType { BUF_REPORT_I, BUF_REPORT_F, BUF_DEPLOY_I };
+}
+
+/// Writes records in the tab-separated text format of output.txt, where the
+/// second column packs age group, cohort set, species, genotype and drug.
+struct TextSink {
+    explicit TextSink( ostream& stream ) : stream(stream) {}
+    
+    // Age group, species and drug are output numbers (0 when not
+    // categorised, otherwise starting from 1); cohortSet is the output id.
+    template<typename T>
+    void put( int survey, size_t ageGroup, uint32_t cohortSet, size_t species,
+              size_t genotype, size_t drug, int measure, T value )
+    {
+        // Yeah, >999 age groups clashes with cohort sets, but unlikely a real issue
+        const int col2 = ageGroup + species + 1000 * cohortSet +
+            1000000 * (genotype + drug);
+        stream << survey << '\t' << col2 << '\t' << measure
+            << '\t' << value << lineEnd;
+    }
+    
+    ostream& stream;
+};
+
+namespace impl {
+    // Cohort sets are stored sparsely: each cohort set observed in a report
+    // is given a compact index on first use, and stores only allocate space
+    // for cohort sets with an index. cohortIndexMap maps cohort sets to
+    // compact indices; observedCohortSets is the inverse. sortedCohortSets
+    // lists the same sets in increasing order, for output.
+    const uint32_t noCohortIndex = static_cast<uint32_t>(-1);
+    boost::unordered_map<uint32_t,uint32_t> cohortIndexMap;
+    vector<uint32_t> observedCohortSets;
+    vector<uint32_t> sortedCohortSets;
+    // The cohort set list of measures not categorised by cohort
+    const vector<uint32_t> noCohortSets( 1, 0 );
+    
+    void rebuildCohortIndexMap(){
+        cohortIndexMap.clear();
+        for( size_t i = 0; i < observedCohortSets.size(); ++i ){
+            assert( observedCohortSets[i] < nCohorts );
+            cohortIndexMap[observedCohortSets[i]] = i;
+        }
+        sortedCohortSets = observedCohortSets;
+        std::sort( sortedCohortSets.begin(), sortedCohortSets.end() );
+    }
+    // Get the compact index of a cohort set, assigning one if necessary
+    inline uint32_t cohortIndex( uint32_t cohortSet ){
+        assert( cohortSet < nCohorts );
+        boost::unordered_map<uint32_t,uint32_t>::const_iterator it =
+            cohortIndexMap.find( cohortSet );
+        if( it != cohortIndexMap.end() ) return it->second;
+        const uint32_t c = observedCohortSets.size();
+        cohortIndexMap[cohortSet] = c;
+        observedCohortSets.push_back( cohortSet );
+        sortedCohortSets.insert( std::upper_bound( sortedCohortSets.begin(),
+                sortedCohortSets.end(), cohortSet ), cohortSet );
+        return c;
+    }
+    // Get the compact index of a cohort set or noCohortIndex if not observed
+    inline uint32_t findCohortIndex( uint32_t cohortSet ){
+        boost::unordered_map<uint32_t,uint32_t>::const_iterator it =
+            cohortIndexMap.find( cohortSet );
+        return it == cohortIndexMap.end() ? noCohortIndex : it->second;
+    }
 }
 
 /// One of these is used for every output index, and is specific to a measure
@@ -65,7 +139,8 @@ struct MonIndex {
     Measure measure;
     // Measure number used in output file
     int outMeasure;
-    // Index of first item in result array
+    // Index of first item in result array (Store::reports or, if byCohort,
+    // a block of Store::cohortReports)
     size_t offset;
     // Number of categories. Must be > 0. If 1, index is set to zero, otherwise
     // indices *should* be less than this.
@@ -76,24 +151,26 @@ struct MonIndex {
     // least one of Deploy::TIMED, Deploy::CTS, Deploy::TREAT.
     uint8_t deployMask;
     
+    // True when categorised by cohort set. Cohort sets are not part of the
+    // index; data is instead stored in a separate block for each cohort set.
+    inline bool byCohort() const{ return nCohorts > 1; }
+    
     // Used to calculate next offset. This is max output of `index(...)` + 1.
     inline size_t size() const{
-        return nAges * nCohorts * nSpecies * nGenotypes * nDrugs;
+        return nAges * nSpecies * nGenotypes * nDrugs;
     }
-    // Get the index in the result array to store this data at
-    // (age group, cohort, species, genotype, drug).
+    // Get the index in the result array (or cohort block) to store this data
+    // at (age group, species, genotype, drug).
     // 
     // First index is `self.offset`, last is `self.offset + self.size() - 1`.
-    size_t index( size_t a, size_t c, size_t sp, size_t g, size_t d ) const{
+    size_t index( size_t a, size_t sp, size_t g, size_t d ) const{
 #ifndef NDEBUG
         if( (nAges > 1 && a >= nAges) ||
-            (nCohorts > 1 && c >= nCohorts) ||
             (nSpecies > 1 && sp >= nSpecies) ||
             (nGenotypes > 1 && g >= nGenotypes) ||
             (nDrugs > 1 && d >= nDrugs)
         ){
             cout << "Index out of bounds for age group\t" << a << " of " << nAges
-                << "\ncohort set\t" << c << " of " << nCohorts
                 << "\nspecies\t" << sp << " of " << nSpecies
                 << "\ngenotype\t" << g << " of " << nGenotypes
                 << "\ndrug\t" << d << " of " << nDrugs
@@ -106,62 +183,56 @@ struct MonIndex {
             (d % nDrugs) + nDrugs *
             ((g % nGenotypes) + nGenotypes *
             ((sp % nSpecies) + nSpecies *
-            ((c % nCohorts) + nCohorts *
-            (a % nAges))));
+            (a % nAges)));
     }
     
     // Write out some data from results.
     // 
-    // @param stream Data sink
+    // @param sink Data sink; see TextSink and SurveyColumns
     // @param surveyNum Number to write in output (should start from 1 unlike in code)
-    // @param results Vector of results
-    // @param surveyStart Index in results where data for the current survey starts
-    template<typename T>
-    void write( ostream& stream, int surveyNum, const OutMeasure& om,
-            const vector<T>& results, size_t surveyStart ) const
+    // @param store The Store holding this index
+    // @param survey Index of the survey to write (from 0)
+    template<typename Sink, typename StoreT>
+    void write( Sink& sink, int surveyNum, const OutMeasure& om,
+            const StoreT& store, size_t survey ) const
     {
-        assert(results.size() >= surveyStart + size());
+        typedef typename StoreT::value_type T;
         // First age group starts at 1, unless there isn't an age group:
         const int ageGroupAdd = om.byAge ? 1 : 0;
         // Number of *reported* age categories: either no categorisation (1) or there is an extra unreported category
         size_t nAgeCats = nAges == 1 ? 1 : nAges - 1;
+        // Only cohort sets which have been observed have any data
+        const vector<uint32_t>& cohortSets = byCohort() ?
+            impl::sortedCohortSets : impl::noCohortSets;
         if( om.bySpecies ){
             assert( nAges == 1 && nCohorts == 1 && nDrugs == 1 );
             for( size_t species = 0; species < nSpecies; ++species ){
             for( size_t genotype = 0; genotype < nGenotypes; ++genotype ){
-                const int col2 = species + 1 +
-                    1000000 * genotype;
-                T value = results[surveyStart + index(0, 0, species, genotype, 0)];
-                stream << surveyNum << '\t' << col2 << '\t' << om.outId
-                    << '\t' << value << lineEnd;
+                T value = store.get( *this, survey, 0, 0, species, genotype, 0 );
+                sink.put( surveyNum, 0, 0, species + 1, genotype, 0,
+                          om.outId, value );
             } }
         }else if( om.byDrug ){
             assert( nSpecies == 1 && nGenotypes == 1 );
-            for( size_t cohortSet = 0; cohortSet < nCohorts; ++cohortSet ){
+            foreach( uint32_t cohortSet, cohortSets ){
             // Last age category is not reported
             for( size_t ageGroup = 0; ageGroup < nAgeCats; ++ageGroup ){
             for( size_t drug = 0; drug < nDrugs; ++drug ){
-                // Yeah, >999 age groups clashes with cohort sets, but unlikely a real issue
-                const int col2 = ageGroup + ageGroupAdd +
-                    1000 * internal::cohortSetOutputId( cohortSet ) +
-                    1000000 * (drug + 1);
-                T value = results[surveyStart + index(ageGroup, cohortSet, 0, 0, drug)];
-                stream << surveyNum << '\t' << col2 << '\t' << om.outId
-                    << '\t' << value << lineEnd;
+                T value = store.get( *this, survey, ageGroup, cohortSet, 0, 0, drug );
+                sink.put( surveyNum, ageGroup + ageGroupAdd,
+                          internal::cohortSetOutputId( cohortSet ), 0, 0,
+                          drug + 1, om.outId, value );
             } } }
         }else{
             assert( nSpecies == 1 && nDrugs == 1 );
-            for( size_t cohortSet = 0; cohortSet < nCohorts; ++cohortSet ){
+            foreach( uint32_t cohortSet, cohortSets ){
             // Last age category is not reported
             for( size_t ageGroup = 0; ageGroup < nAgeCats; ++ageGroup ){
             for( size_t genotype = 0; genotype < nGenotypes; ++genotype ){
-                // Yeah, >999 age groups clashes with cohort sets, but unlikely a real issue
-                const int col2 = ageGroup + ageGroupAdd +
-                    1000 * internal::cohortSetOutputId( cohortSet ) +
-                    1000000 * genotype;
-                T value = results[surveyStart + index(ageGroup, cohortSet, 0, genotype, 0)];
-                stream << surveyNum << '\t' << col2 << '\t' << om.outId
-                    << '\t' << value << lineEnd;
+                T value = store.get( *this, survey, ageGroup, cohortSet, 0, genotype, 0 );
+                sink.put( surveyNum, ageGroup + ageGroupAdd,
+                          internal::cohortSetOutputId( cohortSet ), 0,
+                          genotype, 0, om.outId, value );
             } } }
         }
     }
@@ -170,7 +241,7 @@ struct MonIndex {
 struct MonIndByMeasure{
     bool operator() (const MonIndex& i,const MonIndex& j) {
         if( i.measure != j.measure ) return i.measure < j.measure;
-        else return i.size() < j.size();
+        else return i.size() * i.nCohorts < j.size() * j.nCohorts;
     }
 } monIndByMeasure;
 
@@ -178,7 +249,9 @@ struct MonIndByMeasure{
 template<typename T>
 class Store{
 public:
-    Store() : surveySize(0) {}
+    typedef T value_type;
+    
+    Store() : surveySize(0), cohortSurveySize(0) {}
     
 private:
     // This lists all enabled outputs, sorted by `measure` (first field, of
@@ -193,12 +266,38 @@ private:
     
     // Number of indices in `reports` used by a single survey
     size_t surveySize;
-    // These are the stored reports (multidimensional; size is `size()` and
-    // indices are `survey * surveySize + measures[m].index(...)` for some `m`).
+    // These are the stored reports of measures not categorised by cohort
+    // (multidimensional; size is `size()` and indices are
+    // `survey * surveySize + measures[m].index(...)` for some `m`).
     vector<T> reports;
     
+    // Number of indices in a cohort block used by a single survey
+    size_t cohortSurveySize;
+    // Stored reports of measures categorised by cohort: one block of size
+    // `cohortBlockSize()` for each compact cohort index (see
+    // impl::cohortIndex()), allocated when first needed. Indices are
+    // `(c * nSurveys + survey) * cohortSurveySize + measures[m].index(...)`.
+    vector<T> cohortReports;
+    
     // get size of reports
     inline size_t size(){ return surveySize * impl::nSurveys; }
+    inline size_t cohortBlockSize() const{ return cohortSurveySize * impl::nSurveys; }
+    
+    // Get the index in `reports` or `cohortReports` of some value, allocating
+    // space for a new cohort block if necessary.
+    inline size_t reportIndex( const MonIndex& ind, size_t survey, size_t ageIndex,
+            uint32_t cohortSet, size_t species, size_t genotype, size_t drug )
+    {
+        if( ind.byCohort() ){
+            const size_t c = impl::cohortIndex( cohortSet );
+            const size_t blockEnd = (c + 1) * cohortBlockSize();
+            if( cohortReports.size() < blockEnd ) cohortReports.resize( blockEnd, 0 );
+            return (c * impl::nSurveys + survey) * cohortSurveySize +
+                ind.index(ageIndex, species, genotype, drug);
+        }else{
+            return survey * surveySize + ind.index(ageIndex, species, genotype, drug);
+        }
+    }
     
 public:
     // Set up ready to accept reports. The passed list includes all measures
@@ -228,6 +327,7 @@ public:
         // Leave a few spare slots for potential conditions using variables not already reported:
         reports.reserve(size() + 12);
         reports.assign(size(), 0);
+        cohortReports.clear();
     }
     
     // Enable reporting by an additional measure, which does not categorise.
@@ -264,16 +364,20 @@ public:
         
         sortEnabledMeasures();
         reports.resize(size(), 0);
+        assert( cohortReports.empty() );        // no reports yet
     }
     
-    // Sort measures, then fix the offsets and surveySize, then set measure_map
+    // Sort measures, then fix the offsets, surveySize and cohortSurveySize,
+    // then set measure_map
     void sortEnabledMeasures() {
         std::sort( measures.begin(), measures.end(), monIndByMeasure );
         measure_map.assign(M_NUM, make_pair(0, 0));
         surveySize = 0;
+        cohortSurveySize = 0;
         for( size_t i = 0; i < measures.size(); ++i ){
-            measures[i].offset = surveySize;
-            surveySize += measures[i].size();
+            size_t& regionSize = measures[i].byCohort() ? cohortSurveySize : surveySize;
+            measures[i].offset = regionSize;
+            regionSize += measures[i].size();
             
             Measure m = measures[i].measure;
             assert(m < measure_map.size());
@@ -290,6 +394,12 @@ public:
                  uint32_t cohortSet, size_t species, size_t genotype, size_t drug )
     {
         if( survey == NOT_USED ) return; // pre-main-sim & unit tests we ignore all reports
+        if( impl::reportBuffer != 0 ){
+            impl::reportBuffer->add( typeid(T) == typeid(double) ?
+                    impl::BUF_REPORT_F : impl::BUF_REPORT_I, val, measure,
+                    survey, ageIndex, cohortSet, species, genotype, drug );
+            return;
+        }
         assert(measure < measure_map.size());
         for( size_t i = measure_map[measure].first, end = measure_map[measure].second;
             i < end; ++i )
@@ -299,10 +409,11 @@ public:
             assert(ind.measure == measure);
             if( ind.deployMask != Deploy::NA ) continue;        // skip measures tracking deployments
             
-            size_t index = survey * surveySize +
-                    ind.index(ageIndex, cohortSet, species, genotype, drug);
-            assert( index < reports.size() );
-            reports[index] += val;
+            const size_t index = reportIndex( ind, survey, ageIndex, cohortSet,
+                    species, genotype, drug );
+            vector<T>& data = ind.byCohort() ? cohortReports : reports;
+            assert( index < data.size() );
+            data[index] += val;
         }
     }
     
@@ -314,6 +425,12 @@ public:
         if( survey == NOT_USED ) return; // pre-main-sim & unit tests we ignore all reports
         assert( method == Deploy::TIMED ||
             method == Deploy::CTS || method == Deploy::TREAT );
+        if( impl::reportBuffer != 0 ){
+            assert( typeid(T) == typeid(int) );
+            impl::reportBuffer->add( impl::BUF_DEPLOY_I, val, measure,
+                    survey, ageIndex, cohortSet, 0, 0, method );
+            return;
+        }
         assert(measure < measure_map.size());
         for( size_t i = measure_map[measure].first, end = measure_map[measure].second;
             i < end; ++i )
@@ -325,13 +442,28 @@ public:
             if( (ind.deployMask & method) == Deploy::NA ) continue;
             assert( ind.nSpecies == 1 && ind.nGenotypes == 1 );     // never used for deployments
             
-            size_t index = survey * surveySize +
-                    ind.index(ageIndex, cohortSet, 0, 0, 0);
-            assert( index < reports.size() );
-            reports[index] += val;
+            const size_t index = reportIndex( ind, survey, ageIndex, cohortSet, 0, 0, 0 );
+            vector<T>& data = ind.byCohort() ? cohortReports : reports;
+            assert( index < data.size() );
+            data[index] += val;
         }
     }
     
+    /// Get a stored value (zero for a cohort set never reported).
+    T get( const MonIndex& ind, size_t survey, size_t ageIndex,
+           uint32_t cohortSet, size_t species, size_t genotype, size_t drug ) const
+    {
+        const size_t index = ind.index(ageIndex, species, genotype, drug);
+        if( ind.byCohort() ){
+            const uint32_t c = impl::findCohortIndex( cohortSet );
+            if( c == impl::noCohortIndex ) return 0;
+            const size_t i = (c * impl::nSurveys + survey) * cohortSurveySize + index;
+            // Blocks are allocated by whichever store first sees the cohort set
+            return i < cohortReports.size() ? cohortReports[i] : 0;
+        }
+        return reports[survey * surveySize + index];
+    }
+    
     /// Get the sum of all reported values for some measure, method and survey.
     /// 
     /// Method may be a bit-or-ed combination of Deploy flags, but must exactly
@@ -348,12 +480,22 @@ public:
             assert(ind.measure == measure);
             if( ind.deployMask != method ) continue;    // incompatible deployment mode: skip
             
-            const size_t off = survey * surveySize + ind.offset;
             T sum = 0;
-            size_t end2 = off + ind.size();
-            assert(end2 <= reports.size());
-            for( size_t i = off; i < end2; ++i ){
-                sum += reports[i];
+            if( ind.byCohort() ){
+                const size_t nBlocks = cohortReports.size() / cohortBlockSize();
+                for( size_t c = 0; c < nBlocks; ++c ){
+                    const size_t off = (c * impl::nSurveys + survey) * cohortSurveySize + ind.offset;
+                    for( size_t j = off, end2 = off + ind.size(); j < end2; ++j ){
+                        sum += cohortReports[j];
+                    }
+                }
+            }else{
+                const size_t off = survey * surveySize + ind.offset;
+                size_t end2 = off + ind.size();
+                assert(end2 <= reports.size());
+                for( size_t j = off; j < end2; ++j ){
+                    sum += reports[j];
+                }
             }
             return sum;
         }
@@ -367,28 +509,40 @@ public:
         return measure_map[measure].second > measure_map[measure].first;
     }
     
-    // Write stored values to stream for some output measure, om
-    void write( ostream& stream, size_t survey, const OutMeasure& om ){
+    // Write stored values to sink for some output measure, om
+    template<typename Sink>
+    void write( Sink& sink, size_t survey, const OutMeasure& om ){
         assert(om.m < measure_map.size());
         for( size_t i = measure_map[om.m].first, end = measure_map[om.m].second;
             i < end; ++i )
         {
             assert(i < measures.size());
             if( measures[i].outMeasure == om.outId ){
-                measures[i].write( stream, survey + 1, om, reports, survey * surveySize );
+                measures[i].write( sink, survey + 1, om, *this, survey );
                 return;
             }
         }
         assert(false && "measure not found in records");
     }
     
+    // Heap memory used by this store
+    size_t memoryBytes() const{
+        return measures.capacity() * sizeof(MonIndex) +
+            measure_map.capacity() * sizeof(MeasureRange) +
+            (reports.capacity() + cohortReports.capacity()) * sizeof(T);
+    }
+    
     // Checkpointing
     void checkpoint( ostream& stream ){
         reports.size() & stream;
         foreach (T& y, reports) {
             y & stream;
         }
-        // reports is the only field which changes after initialisation
+        cohortReports.size() & stream;
+        foreach (T& y, cohortReports) {
+            y & stream;
+        }
+        // reports and cohortReports are the only fields which change after initialisation
     }
     void checkpoint( istream& stream ){
         size_t l;
@@ -400,7 +554,15 @@ public:
         foreach (T& y, reports) {
             y & stream;
         }
-        // reports is the only field which changes after initialisation
+        l & stream;
+        if( l > 0 && (cohortBlockSize() == 0 || l % cohortBlockSize() != 0) ){
+            throw util::checkpoint_error( "mon::cohortReports: invalid list size" );
+        }
+        cohortReports.resize (l);
+        foreach (T& y, cohortReports) {
+            y & stream;
+        }
+        // reports and cohortReports are the only fields which change after initialisation
     }
 };
 
@@ -525,10 +687,28 @@ void internal::initReporting( const scnXml::Scenario& scenario ){
     size_t nDrugs = scenario.getPharmacology().present() ?
         scenario.getPharmacology().get().getDrugs().getDrug().size() : 1;
     
+    impl::observedCohortSets.clear();
+    impl::rebuildCohortIndexMap();
     storeI.init( reportedMeasures, nSpecies, nDrugs );
     storeF.init( reportedMeasures, nSpecies, nDrugs );
 }
 
+void internal::clearReporting(){
+    reportedMeasures.clear();
+    storeI = Store<int>();
+    storeF = Store<double>();
+    reportIMR = -1;
+    impl::conditions.clear();
+    
+    impl::isInit = false;
+    impl::surveyIndex = 0;
+    impl::survNumEvent = NOT_USED;
+    impl::survNumStat = NOT_USED;
+    impl::nextSurveyTime = SimTime::future();
+    impl::observedCohortSets.clear();
+    impl::rebuildCohortIndexMap();
+}
+
 size_t setupCondition( const string& measureName, double minValue,
                        double maxValue, bool initialState )
 {
@@ -571,7 +751,8 @@ bool checkCondition( size_t conditionKey ){
     return impl::conditions[conditionKey].value;
 }
 
-void internal::write( ostream& stream ){
+template<typename Sink>
+void writeRecords( Sink& sink ){
     for( size_t survey = 0; survey < impl::nSurveys; ++survey ){
         foreach( const OutMeasure& om, reportedMeasures ){
             if( om.m >= M_NUM ){
@@ -579,9 +760,9 @@ void internal::write( ostream& stream ){
                 assert( om.m == M_ALL_CAUSE_IMR && reportIMR >= 0 );
                 continue;
             } else if( om.isDouble ) {
-                storeF.write( stream, survey, om );
+                storeF.write( sink, survey, om );
             } else {
-                storeI.write( stream, survey, om );
+                storeI.write( sink, survey, om );
             }
         }
     }
@@ -589,11 +770,76 @@ void internal::write( ostream& stream ){
         // Infant mortality rate is a single number, therefore treated specially.
         // It is calculated across the entire intervention period and used in
         // model fitting.
-        stream << 1 << "\t" << 1 << "\t" << reportIMR
-            << "\t" << Clinical::infantAllCauseMort() << lineEnd;
+        sink.put( 1, 1, 0, 0, 0, 0, reportIMR, Clinical::infantAllCauseMort() );
     }
 }
 
+void internal::write( ostream& stream ){
+    TextSink sink( stream );
+    writeRecords( sink );
+}
+
+// Binary format header constants
+const uint32_t bin_BOM = 0x4F424D4F;    // "OMBO" in little-endian: OpenMalaria Binary Output
+const uint32_t bin_version = 1;
+
+template<typename T>
+void binaryWrite( ostream& stream, T x ){
+    stream.write( reinterpret_cast<const char*>(&x), sizeof(x) );
+}
+template<typename T>
+void binaryWriteColumn( ostream& stream, const char* name, char type,
+                        const vector<T>& column )
+{
+    // Column descriptor: name length, name, type code, width in bytes
+    const uint8_t len = strlen( name );
+    binaryWrite( stream, len );
+    stream.write( name, len );
+    binaryWrite( stream, type );
+    binaryWrite( stream, static_cast<uint8_t>(sizeof(T)) );
+}
+template<typename T>
+void binaryWriteData( ostream& stream, const vector<T>& column ){
+    if( column.empty() ) return;
+    stream.write( reinterpret_cast<const char*>(&column[0]),
+                  column.size() * sizeof(T) );
+}
+
+void collectSurveyData( SurveyColumns& columns ){
+    columns = SurveyColumns();
+    writeRecords( columns );
+}
+
+void internal::writeBinary( ostream& stream ){
+    SurveyColumns sink;
+    writeRecords( sink );
+    
+    // Header: BOM (also identifies byte order), format version, number of
+    // columns, number of rows, then one descriptor per column.
+    binaryWrite( stream, bin_BOM );
+    binaryWrite( stream, bin_version );
+    binaryWrite( stream, static_cast<uint32_t>(8) );
+    binaryWrite( stream, static_cast<uint64_t>(sink.rows()) );
+    binaryWriteColumn( stream, "survey", 'u', sink.surveys );
+    binaryWriteColumn( stream, "ageGroup", 'u', sink.ageGroups );
+    binaryWriteColumn( stream, "cohortSet", 'u', sink.cohortSets );
+    binaryWriteColumn( stream, "species", 'u', sink.speciesIds );
+    binaryWriteColumn( stream, "genotype", 'u', sink.genotypes );
+    binaryWriteColumn( stream, "drug", 'u', sink.drugs );
+    binaryWriteColumn( stream, "measure", 'i', sink.measures );
+    binaryWriteColumn( stream, "value", 'f', sink.values );
+    
+    // Data: each column in turn, in the order described above
+    binaryWriteData( stream, sink.surveys );
+    binaryWriteData( stream, sink.ageGroups );
+    binaryWriteData( stream, sink.cohortSets );
+    binaryWriteData( stream, sink.speciesIds );
+    binaryWriteData( stream, sink.genotypes );
+    binaryWriteData( stream, sink.drugs );
+    binaryWriteData( stream, sink.measures );
+    binaryWriteData( stream, sink.values );
+}
+
 // Report functions: each reports to all usable stores (i.e. correct data type
 // and where parameters don't have to be fabricated).
 // void reportMI( Measure measure, int val ){
@@ -676,16 +922,45 @@ void reportStatMSGF( Measure measure, size_t species, size_t genotype, double va
     storeF.report( val, measure, survey, 0, 0, species, genotype, 0 );
 }
 
+void ReportBuffer::replay( size_t begin, size_t end ) const{
+    assert( impl::reportBuffer == 0 && end <= records.size() );
+    for( size_t i = begin; i < end; ++i ){
+        const Record& r = records[i];
+        const Measure measure = static_cast<Measure>( r.measure );
+        if( r.type == impl::BUF_REPORT_F ){
+            storeF.report( r.value, measure, r.survey, r.ageIndex,
+                    r.cohortSet, r.species, r.genotype, r.drug );
+        }else if( r.type == impl::BUF_REPORT_I ){
+            storeI.report( static_cast<int>( r.value ), measure, r.survey,
+                    r.ageIndex, r.cohortSet, r.species, r.genotype, r.drug );
+        }else{
+            assert( r.type == impl::BUF_DEPLOY_I );
+            storeI.deploy( static_cast<int>( r.value ), measure, r.survey,
+                    r.ageIndex, r.cohortSet, static_cast<Deploy::Method>( r.drug ) );
+        }
+    }
+}
+
+void setReportBuffer( ReportBuffer* buffer ){
+    impl::reportBuffer = buffer;
+}
+
 bool isUsedM( Measure measure ){
     return storeI.isUsed(measure) || storeF.isUsed(measure);
 }
 
+void memoryStats( util::MemoryStats& stats ){
+    stats.add( "monitoring store buffers", 2,
+               storeI.memoryBytes() + storeF.memoryBytes() );
+}
+
 void checkpoint( ostream& stream ){
     impl::isInit & stream;
     impl::surveyIndex & stream;
     impl::survNumEvent & stream;
     impl::survNumStat & stream;
     impl::nextSurveyTime & stream;
+    impl::observedCohortSets & stream;
     
     storeI.checkpoint(stream);
     storeF.checkpoint(stream);
@@ -696,6 +971,8 @@ void checkpoint( istream& stream ){
     impl::survNumEvent & stream;
     impl::survNumStat & stream;
     impl::nextSurveyTime & stream;
+    impl::observedCohortSets & stream;
+    impl::rebuildCohortIndexMap();
     
     storeI.checkpoint(stream);
     storeF.checkpoint(stream);
@@ -24,6 +24,7 @@
 #include "Global.h"
 #include "Simulator.h"
 #include "util/CommandLine.h"
+#include "util/InitCache.h"
 #include "util/errors.h"
 
 #include <cstdio>
@@ -44,6 +45,8 @@ int main(int argc, char* argv[]) {
         
         util::BoincWrapper::init();     // BOINC init
         
+        util::InitCache::init();
+        
         // Load the scenario document:
         scenarioFile = util::CommandLine::lookupResource (scenarioFile);
         util::DocumentLoader documentLoader;
@@ -54,6 +57,8 @@ int main(int argc, char* argv[]) {
         
         // Save changes to the document if any occurred.
         documentLoader.saveDocument();
+        // Initialisation succeeded, so its products may be reused:
+        util::InitCache::save();
         
         if ( !util::CommandLine::option(util::CommandLine::SKIP_SIMULATION) )
             simulator.start(documentLoader.document().getMonitoring());
@@ -31,6 +31,7 @@
 #include <memory>
 
 class UnittestUtil;
+class ModelFixture;
 
 namespace scnXml {
     class Scenario;
@@ -305,6 +306,13 @@ public:
     /** During updates, this is ts0; between, it is now - 1. */
     static inline SimTime latestTs0(){ return time1 - SimTime::oneTS(); }
     
+    /** True if time t is within the current step, [ts0(), ts1()). With a
+     * 1-day step this is the same as t == ts0(). Only use during updates. */
+    static inline bool inCurrentStep( SimTime t ){
+        assert(in_update);
+        return time0 <= t && t < time1;
+    }
+    
     /** Time relative to the intervention period. Some events are defined
      * relative to this time rather than simulation time, and since the
      * difference is not known until after the warmup period of the simulation
@@ -315,6 +323,11 @@ public:
     static inline SimTime intervNow(){ return interv_time; }
     
     static inline SimTime maxHumanAge(){ return max_human_age; }
+    
+    /** Length of a time step as configured by the scenario. This equals
+     * SimTime::oneTS() except during a coarse warm-up (model option
+     * COARSE_WARMUP), when the human warm-up uses longer steps. */
+    static inline SimTime scenarioTS(){ return scenario_ts; }
     //@}
     
     ///@brief Population variables (globals)
@@ -334,6 +347,9 @@ public:
 private:
     static void init( const scnXml::Scenario& scenario );
     
+    // Set the time-step length (SimTime::oneTS() and derived constants).
+    static void setOneTS( SimTime ts );
+    
     // Start of update. Set in_update and increment time1.
     static inline void start_update(){
         time1 += SimTime::oneTS();
@@ -351,6 +367,7 @@ private:
     }
     
     static SimTime max_human_age;   // constant
+    static SimTime scenario_ts;     // constant
     // Global variables
 #ifndef NDEBUG
     static bool in_update;       // only true during human/population/transmission update
@@ -364,6 +381,7 @@ private:
     
     friend class Simulator;
     friend class ::UnittestUtil;
+    friend class ::ModelFixture;
 };
 
 }
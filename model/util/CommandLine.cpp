@@ -38,7 +38,10 @@ namespace OM { namespace util {
     bitset<CommandLine::NUM_OPTIONS> CommandLine::options;
     string CommandLine::resourcePath;
     string CommandLine::outputName;
+    string CommandLine::binaryOutputName;
+    string CommandLine::initCacheName;
     string CommandLine::ctsoutName;
+    size_t CommandLine::surveyThreads = 1;
     set<int> CommandLine::checkpoint_times;
     
     string parseNextArg (int argc, char* argv[], int& i) {
@@ -54,6 +57,7 @@ namespace OM { namespace util {
 	bool cloHelp = false, cloVersion = false, cloError = false;
 	string scenarioFile = "";
         outputName = "";
+        binaryOutputName = "";
         ctsoutName = "";
 #	ifdef OM_STREAM_VALIDATOR
 	string sVFile;
@@ -82,11 +86,21 @@ namespace OM { namespace util {
 			throw cmd_exception ("--output argument may only be given once");
 		    }
 		    outputName = parseNextArg (argc, argv, i);
+                } else if (clo == "output-binary") {
+                    if (binaryOutputName != ""){
+                        throw cmd_exception ("--output-binary argument may only be given once");
+                    }
+                    binaryOutputName = parseNextArg (argc, argv, i);
                 } else if (clo == "ctsout") {
                     if (ctsoutName != ""){
                         throw cmd_exception ("--ctsout argument may only be given once");
                     }
                     ctsoutName = parseNextArg (argc, argv, i);
+                } else if (clo == "init-cache") {
+                    if (initCacheName != ""){
+                        throw cmd_exception ("--init-cache argument may only be given once");
+                    }
+                    initCacheName = parseNextArg (argc, argv, i);
                 } else if (clo == "name") {
                     if (ctsoutName != "" || outputName != "" || scenarioFile != ""){
                         throw cmd_exception ("--name may not be used along with --scenario, --output or --ctsout");
@@ -95,6 +109,8 @@ namespace OM { namespace util {
                     (scenarioFile = "scenario").append(name).append(".xml");
                     (outputName = "output").append(name).append(".txt");
                     (ctsoutName = "ctsout").append(name).append(".txt");
+                } else if (clo == "ctsout-binary") {
+                    options.set (CTSOUT_BINARY);
                 } else if (clo == "validate-only") {
                     options.set (SKIP_SIMULATION);
                 } else if (clo == "deprecation-warnings") {
@@ -145,6 +161,21 @@ namespace OM { namespace util {
 		    options.set (TEST_DUPLICATE_CHECKPOINTS);
                 } else if (clo == "debug-vector-fitting") {
                     options.set (DEBUG_VECTOR_FITTING);
+                } else if (clo == "perf-stats") {
+                    options.set (PRINT_PERF_STATS);
+                } else if (clo == "memory-stats") {
+                    options.set (PRINT_MEMORY_STATS);
+                } else if (clo == "verify-fused-update") {
+                    options.set (VERIFY_FUSED_UPDATE);
+                } else if (clo == "survey-threads") {
+                    string n = parseNextArg (argc, argv, i);
+                    try{
+                        surveyThreads = lexical_cast<size_t>(n);
+                    }catch( const boost::bad_lexical_cast& ){
+                        surveyThreads = 0;
+                    }
+                    if (surveyThreads == 0)
+                        throw cmd_exception ("--survey-threads: expected a positive integer");
 #	ifdef OM_STREAM_VALIDATOR
 		} else if (clo == "stream-validator") {
 		    if (sVFile.size())
@@ -227,10 +258,22 @@ namespace OM { namespace util {
 	    << " -s --scenario file.xml	Uses file.xml as the scenario. If not given, scenario.xml is used." << endl
 	    << "			If path is relative (doesn't start '/'), --resource-path is used."<<endl
 	    << " -o --output file.txt	Uses file.txt as output file name. If not given, output.txt is used." << endl
+	    << "    --output-binary file.bin" << endl
+	    << "			Additionally write survey results to file.bin in a binary" << endl
+	    << "			columnar format (see util/readOutput.py)." << endl
 	    << "    --ctsout file.txt	Uses file.txt as ctsout file name. If not given, ctsout.txt is used." << endl
+	    << "    --ctsout-binary	Write continuous output in a binary format (doubles; see" << endl
+	    << "			util/compareCtsout.py). If --ctsout is not given, ctsout.bin is used." << endl
 	    << " -n --name NAME		Equivalent to --scenario scenarioNAME.xml --output outputNAME.txt \\"<<endl
 	    << "			--ctsout ctsoutNAME.txt" <<endl
+	    << "    --init-cache file.bin" << endl
+	    << "			Cache scenario validation and initialisation products in" << endl
+	    << "			file.bin, keyed by scenario content, to speed up repeated" << endl
+	    << "			runs of the same scenario. Created if it doesn't exist." << endl
 	    << "    --validate-only	Initialise and validate scenario, but don't run simulation." << endl
+	    << "    --survey-threads N" << endl
+	    << "			Collect survey data using N threads (default 1). Results do" << endl
+	    << "			not depend on N." << endl
 	    << "    --deprecation-warnings" << endl
 	    << "			Warn about the use of features deemed error-prone and where" << endl
 	    << "			more flexible alternatives are available." << endl
@@ -261,6 +304,15 @@ namespace OM { namespace util {
 	    << "			Show details of vector-parameter fitting. The fitting methods used" <<endl
 	    << "			aren't guaranteed to work. If they don't, this output should help"<<endl
 	    << "			work out why."<<endl
+	    << "    --perf-stats	Print checkpoint sizes and timings and the number of human"<<endl
+	    << "			updates to stderr in a machine-readable form (lines starting"<<endl
+	    << "			'perf'; see test/perf.py)."<<endl
+	    << "    --memory-stats	Print memory use and object counts per subsystem (humans,"<<endl
+	    << "			infections, drugs, interventions, monitoring, vector model)"<<endl
+	    << "			to stderr at each survey and at the end (lines starting 'mem')."<<endl
+	    << "    --verify-fused-update"<<endl
+	    << "			Check that sums for kappa calculated during the human update"<<endl
+	    << "			pass equal those from a separate pass over the population."<<endl
 #	ifdef OM_STREAM_VALIDATOR
 	    << "    --stream-validator PATH" <<endl
 	    << "			Use StreamValidator to validate against reference file PATH." <<endl
@@ -291,7 +343,7 @@ namespace OM { namespace util {
 	    outputName = "output.txt";
 	}
 	if (ctsoutName == ""){
-            ctsoutName = "ctsout.txt";
+            ctsoutName = options[CTSOUT_BINARY] ? "ctsout.bin" : "ctsout.txt";
         }
 #ifndef WITHOUT_BOINC
 	outputName.append(".gz");
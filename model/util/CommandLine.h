@@ -66,6 +66,18 @@ namespace OM { namespace util {
             /** Print times of all surveys. */
             PRINT_SURVEY_TIMES,
             PRINT_GENOTYPES,
+            /** Write continuous output in a binary format instead of text. */
+            CTSOUT_BINARY,
+            /** Print machine-readable performance figures (checkpoint size
+             * and timings, human update counts) to stderr; used by
+             * test/perf.py. */
+            PRINT_PERF_STATS,
+            /** Print memory use and object counts per subsystem at each
+             * survey and at the end (see util::MemoryStats). */
+            PRINT_MEMORY_STATS,
+            /** Calculate transmission sums both during the human update pass
+             * and by a separate pass, and fail if these differ. */
+            VERIFY_FUSED_UPDATE,
 	    NUM_OPTIONS
 	};
 	
@@ -94,11 +106,29 @@ namespace OM { namespace util {
 	    return outputName;
 	}
 	
+        /** Get the name of the binary survey output file, or an empty string
+         * if binary output was not requested. */
+        static inline string getBinaryOutputName (){
+            return binaryOutputName;
+        }
+        
+        /** Get the name of the initialisation cache file, or an empty string
+         * if not caching. */
+        static inline string getInitCacheName (){
+            return initCacheName;
+        }
+        
         /** Get the name of the ctsout file. */
         static inline string getCtsoutName (){
             return ctsoutName;
         }
         
+        /** Get the number of threads to use when collecting survey data
+         * (at least 1). */
+        static inline size_t getSurveyThreads (){
+            return surveyThreads;
+        }
+        
 	/** Looks through all command line options.
 	*
 	* @returns The name of the scenario XML file to use.
@@ -124,7 +154,10 @@ namespace OM { namespace util {
 	
 	//Output filename (for main output file "output.txt")
 	static string outputName;
+        static string binaryOutputName;
+        static string initCacheName;
         static string ctsoutName;
+        static size_t surveyThreads;
 	
 	/** Set of simulation times at which a checkpoint should be written and
 	* program should exit (to allow resume).
@@ -20,12 +20,14 @@
 
 #include "util/DocumentLoader.h"
 #include "util/BoincWrapper.h"
+#include "util/InitCache.h"
 #include "util/errors.h"
 
 #include <iostream>
 #include <sstream>
 #include <fstream>
 #include <map>
+#include <iterator>
 #include <boost/format.hpp>
 
 namespace OM { namespace util {
@@ -45,7 +47,21 @@ Checksum DocumentLoader::loadDocument (std::string lXmlFile){
 	string msg = "Error: unable to open "+lXmlFile;
 	throw util::xml_scenario_error (msg);
     }
-    scenario = scnXml::parseScenario (fileStream);
+    
+    // With --init-cache, documents which have already passed validation are
+    // parsed without it (validation is a large part of start-up time).
+    uint64_t hash = 0;
+    xml_schema::Flags flags = 0;
+    if( InitCache::enabled() ){
+        string content( (istreambuf_iterator<char>(fileStream)), istreambuf_iterator<char>() );
+        hash = InitCache::hashDocument( content );
+        fileStream.clear();
+        fileStream.seekg( 0 );
+        if( InitCache::isValidated( hash ) )
+            flags = xml_schema::Flags::dont_validate;
+    }
+    scenario = scnXml::parseScenario (fileStream, flags);
+    InitCache::setValidated( hash );
     util::Checksum cksum = util::Checksum::generate (fileStream);
     fileStream.close ();
     int scenarioVersion = scenario->getSchemaVersion();
@@ -0,0 +1,173 @@
+/* This file is part of OpenMalaria.
+ *
+ * Copyright (C) 2005-2015 Swiss Tropical and Public Health Institute
+ * Copyright (C) 2005-2015 Liverpool School Of Tropical Medicine
+ *
+ * OpenMalaria is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "util/InitCache.h"
+#include "util/CommandLine.h"
+#include "util/errors.h"
+/* if you get compile errors like "version.h not found", run CMake first */
+#include "util/version.h"
+
+#include <fstream>
+#include <iostream>
+#include <cstdio>
+#include <map>
+#include <set>
+
+namespace OM { namespace util {
+
+namespace {
+    // Limits used to reject corrupt files (not expected in practice)
+    const long MAX_ENTRIES = 100000;
+    const long MAX_DATA_LENGTH = 10000000;
+
+    bool isEnabled = false;
+    bool changed = false;
+    std::set<uint64_t> validated;
+    std::map<std::string, std::vector<double> > products;
+
+    void readCache( istream& stream ){
+        checkpoint::header( stream );
+        string version;
+        version & stream;
+        if( version != semantic_version ){
+            // Written by another version: start afresh
+            return;
+        }
+
+        size_t n;
+        n & stream;
+        checkpoint::validateListSize( n, MAX_ENTRIES );
+        for( size_t i = 0; i < n; ++i ){
+            uint64_t hash;
+            hash & stream;
+            validated.insert( hash );
+        }
+
+        n & stream;
+        checkpoint::validateListSize( n, MAX_ENTRIES );
+        for( size_t i = 0; i < n; ++i ){
+            string key;
+            key & stream;
+            size_t len;
+            len & stream;
+            checkpoint::validateListSize( len, MAX_DATA_LENGTH );
+            vector<double>& data = products[key];
+            data.resize( len );
+            for( size_t j = 0; j < len; ++j ){
+                data[j] & stream;
+            }
+        }
+
+        if( stream.fail() ){
+            throw checkpoint_error( "read failed" );
+        }
+    }
+
+    void writeCache( ostream& stream ){
+        checkpoint::header( stream );
+        semantic_version & stream;
+        validated.size() & stream;
+        foreach( uint64_t hash, validated ){
+            hash & stream;
+        }
+        products.size() & stream;
+        typedef std::map<std::string, std::vector<double> >::value_type Entry;
+        foreach( const Entry& entry, products ){
+            entry.first & stream;
+            entry.second.size() & stream;
+            foreach( double x, entry.second ){
+                x & stream;
+            }
+        }
+    }
+}
+
+void InitCache::init(){
+    const string& name = CommandLine::getInitCacheName();
+    if( name.empty() ) return;
+    isEnabled = true;
+
+    ifstream stream( name.c_str(), ios::in | ios::binary );
+    if( !stream.is_open() ) return;     // no cache yet
+    try{
+        readCache( stream );
+    }catch( const std::exception& e ){
+        cerr << "Warning: ignoring unreadable init cache " << name << ": "
+            << e.what() << endl;
+        validated.clear();
+        products.clear();
+    }
+    stream.close();
+}
+
+void InitCache::save(){
+    if( !isEnabled || !changed ) return;
+    const string& name = CommandLine::getInitCacheName();
+
+    // Write to a temporary file then rename, so that concurrent runs never
+    // read a partial file.
+    const string tmpName = name + ".tmp";
+    ofstream stream( tmpName.c_str(), ios::out | ios::binary );
+    writeCache( stream );
+    stream.close();
+    if( stream.fail() ){
+        throw TRACED_EXCEPTION( "unable to write init cache " + tmpName, Error::FileIO );
+    }
+    std::remove( name.c_str() );        // rename doesn't replace on all platforms
+    if( std::rename( tmpName.c_str(), name.c_str() ) != 0 ){
+        throw TRACED_EXCEPTION( "unable to write init cache " + name, Error::FileIO );
+    }
+    changed = false;
+}
+
+bool InitCache::enabled(){
+    return isEnabled;
+}
+
+uint64_t InitCache::hashDocument( const string& content ){
+    uint64_t hash = 14695981039346656037ULL;
+    for( size_t i = 0; i < content.size(); ++i ){
+        hash ^= static_cast<unsigned char>( content[i] );
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool InitCache::isValidated( uint64_t hash ){
+    return validated.count( hash ) > 0;
+}
+void InitCache::setValidated( uint64_t hash ){
+    if( !isEnabled ) return;
+    changed |= validated.insert( hash ).second;
+}
+
+bool InitCache::get( const string& key, vector<double>& data ){
+    std::map<std::string, std::vector<double> >::const_iterator it = products.find( key );
+    if( it == products.end() ) return false;
+    data = it->second;
+    return true;
+}
+void InitCache::put( const string& key, const vector<double>& data ){
+    if( !isEnabled ) return;
+    products[key] = data;
+    changed = true;
+}
+
+} }
@@ -0,0 +1,67 @@
+/* This file is part of OpenMalaria.
+ *
+ * Copyright (C) 2005-2015 Swiss Tropical and Public Health Institute
+ * Copyright (C) 2005-2015 Liverpool School Of Tropical Medicine
+ *
+ * OpenMalaria is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef Hmod_util_InitCache
+#define Hmod_util_InitCache
+
+#include "Global.h"
+#include <string>
+#include <vector>
+
+namespace OM { namespace util {
+
+/** Optional on-disk cache of start-up work (enabled by --init-cache).
+ *
+ * Stores hashes of scenario documents which have already passed schema
+ * validation (so that they may be parsed without validation next time) and
+ * results of deterministic initialisation computations, keyed by a string
+ * describing their inputs.
+ *
+ * The cache file is tied to the program version: a file written by another
+ * version is ignored (and replaced). A corrupt or unreadable file is ignored
+ * with a warning; the cache never affects simulation results. */
+class InitCache {
+public:
+    /** Load the cache file named on the command line, if any. */
+    static void init();
+
+    /** Write the cache file if anything was added. */
+    static void save();
+
+    /** True if a cache file was named on the command line. */
+    static bool enabled();
+
+    /** Hash of a scenario document's content (64-bit FNV-1a). Used as the key
+     * for validation results; not a security measure. */
+    static uint64_t hashDocument( const std::string& content );
+
+    /// True if the document with this hash passed validation previously.
+    static bool isValidated( uint64_t hash );
+    /// Record that the document with this hash passed validation.
+    static void setValidated( uint64_t hash );
+
+    /** Look up a cached result. Returns true and sets data if found. */
+    static bool get( const std::string& key, std::vector<double>& data );
+    /** Store a result (replacing any previous value). */
+    static void put( const std::string& key, const std::vector<double>& data );
+};
+
+} }
+#endif
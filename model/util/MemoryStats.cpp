@@ -0,0 +1,50 @@
+/* This file is part of OpenMalaria.
+ *
+ * Copyright (C) 2005-2015 Swiss Tropical and Public Health Institute
+ * Copyright (C) 2005-2015 Liverpool School Of Tropical Medicine
+ *
+ * OpenMalaria is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "util/MemoryStats.h"
+#include "util/CommandLine.h"
+
+namespace OM { namespace util {
+
+bool MemoryStats::enabled(){
+    return CommandLine::option( CommandLine::PRINT_MEMORY_STATS );
+}
+
+void MemoryStats::add( const char* category, size_t count, size_t bytes ){
+    Entry& entry = entries[category];
+    entry.count += count;
+    entry.bytes += bytes;
+}
+
+void MemoryStats::write( ostream& stream ) const{
+    const int t = sim::now().inSteps();
+    Entry total;
+    typedef std::map<std::string, Entry>::value_type Pair;
+    foreach( const Pair& pair, entries ){
+        stream << "mem\t" << t << '\t' << pair.first << '\t'
+            << pair.second.count << '\t' << pair.second.bytes << '\n';
+        total.count += pair.second.count;
+        total.bytes += pair.second.bytes;
+    }
+    stream << "mem\t" << t << "\ttotal\t" << total.count << '\t'
+        << total.bytes << endl;
+}
+
+} }
@@ -0,0 +1,71 @@
+/* This file is part of OpenMalaria.
+ *
+ * Copyright (C) 2005-2015 Swiss Tropical and Public Health Institute
+ * Copyright (C) 2005-2015 Liverpool School Of Tropical Medicine
+ *
+ * OpenMalaria is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef Hmod_util_MemoryStats
+#define Hmod_util_MemoryStats
+
+#include "Global.h"
+#include <map>
+#include <string>
+#include <vector>
+#include <ostream>
+
+namespace OM { namespace util {
+
+/** Accumulates object counts and memory use per subsystem (enabled by
+ * --memory-stats).
+ *
+ * Figures are computed by walking the model's data structures, not by
+ * tracking allocations: each object adds its own size plus heap memory it
+ * owns. Container node overheads are estimates (allocator overhead is not
+ * included), so totals are a lower bound on process memory. */
+class MemoryStats {
+public:
+    /// Approximate per-element overhead of std::list / boost::ptr_list
+    /// and std::map nodes (beyond the element itself)
+    static const size_t LIST_NODE = 2 * sizeof(void*);
+    static const size_t MAP_NODE = 4 * sizeof(void*);
+    
+    /// True if requested on the command line
+    static bool enabled();
+    
+    /// Add count objects using bytes in total to category
+    void add( const char* category, size_t count, size_t bytes );
+    
+    /// Heap memory held by a vector
+    template<class T>
+    static inline size_t bytes( const std::vector<T>& vec ){
+        return vec.capacity() * sizeof(T);
+    }
+    
+    /** Write one tab-separated line per category, prefixed "mem" and the
+     * time step, followed by a total. */
+    void write( std::ostream& stream ) const;
+    
+private:
+    struct Entry {
+        Entry() : count(0), bytes(0) {}
+        size_t count, bytes;
+    };
+    std::map<std::string, Entry> entries;
+};
+
+} }
+#endif
@@ -76,6 +76,10 @@ namespace OM { namespace util {
             ignoreOptions.insert("PROPHYLACTIC_DRUG_ACTION_MODEL");
             codeMap["VIVAX_SIMPLE_MODEL"] = VIVAX_SIMPLE_MODEL;
             codeMap["INDIRECT_MORTALITY_FIX"] = INDIRECT_MORTALITY_FIX;
+            codeMap["LSTM_PKPD_GAUSS_LEGENDRE"] = LSTM_PKPD_GAUSS_LEGENDRE;
+            codeMap["COARSE_WARMUP"] = COARSE_WARMUP;
+            codeMap["GEOMETRIC_SKIP_SAMPLING"] = GEOMETRIC_SKIP_SAMPLING;
+            codeMap["COMMON_RANDOM_NUMBERS"] = COMMON_RANDOM_NUMBERS;
 	}
 	
 	OptionCodes operator[] (const string s) {
@@ -219,7 +223,12 @@ namespace OM { namespace util {
             .set( DUMMY_WITHIN_HOST_MODEL )
             .set( EMPIRICAL_WITHIN_HOST_MODEL )
             .set( MOLINEAUX_WITHIN_HOST_MODEL )
-            .set( PENNY_WITHIN_HOST_MODEL );
+            .set( PENNY_WITHIN_HOST_MODEL )
+            .set( COARSE_WARMUP );
+        
+        // skipping draws one number for many humans, so can't use per-human streams
+        incompatibilities[COMMON_RANDOM_NUMBERS]
+            .set( GEOMETRIC_SKIP_SAMPLING );
         
 	for(size_t i = 0; i < NUM_OPTIONS; ++i) {
 	    if (options [i] && (options & incompatibilities[i]).any()) {
@@ -252,7 +261,8 @@ namespace OM { namespace util {
             // 5 day TS is okay; some tests specific to this TS:
             bitset<NUM_OPTIONS> require1DayTS;
             require1DayTS
-                .set( CLINICAL_EVENT_SCHEDULER );
+                .set( CLINICAL_EVENT_SCHEDULER )
+                .set( COARSE_WARMUP );
             
             for(size_t i = 0; i < NUM_OPTIONS; ++i) {
                 if (options [i] && require1DayTS[i]) {
@@ -241,6 +241,44 @@ namespace OM { namespace util {
          */
         CFR_PF_USE_HOSPITAL,
         
+        /** Numerical method: integrate the killing function of two- and
+         * three-compartment drug models (LSTMDrugThreeComp) over each day
+         * with fixed-order Gauss-Legendre quadrature, falling back to
+         * adaptive (QAG) integration only when the error estimate is too
+         * large. This is faster but results differ slightly (within the
+         * integration tolerances) from the default method. */
+        LSTM_PKPD_GAUSS_LEGENDRE,
+        
+        /** Performance option for scenarios with a 1-day time step: run the
+         * human warm-up (the one-life-span phase before transmission
+         * initialisation) with a 5-day step, switching to 1-day steps before
+         * the transmission initialisation phase.
+         * 
+         * Within-host state is converted at the switch, but clinical episode
+         * probabilities are per time step, so results differ from those
+         * without this option; the warm-up is only used to bring immunity to
+         * equilibrium. Requires a 1-day time step. */
+        COARSE_WARMUP,
+        
+        /** Performance option: for timed mass deployments (including
+         * cumulative deployments) and imported infections, select recipients
+         * by sampling the gap to the next recipient from a geometric
+         * distribution instead of sampling once per eligible human. The
+         * distribution of recipients is unchanged but the random number
+         * stream differs, so results are not identical. */
+        GEOMETRIC_SKIP_SAMPLING,
+        
+        /** Common random numbers: each stochastic process (host
+         * heterogeneity at birth, infection incidence, within-host model,
+         * case management, intervention deployment and the transmission
+         * model) draws from its own sub-stream, seeded from iseed, the
+         * process, the human and the time step (see
+         * util::random::SubStream). Two scenarios differing only in their
+         * interventions then share random numbers wherever the simulations
+         * do not diverge, reducing the number of replicates needed to
+         * compare them. Results differ from those without this option. */
+        COMMON_RANDOM_NUMBERS,
+        
 	// Used by tests; should be 1 more than largest option
 	NUM_OPTIONS,
         
@@ -40,6 +40,7 @@ int SimTime::interval;
 size_t SimTime::steps_per_year;
 double SimTime::years_per_step;
 SimTime sim::max_human_age;
+SimTime sim::scenario_ts;
 SimTime interv_start_date;
 
 // global variables:
@@ -243,10 +244,15 @@ ostream& operator<<( ostream& stream, TimeDisplayHelper timeDisplay ){
     return stream;
 }
 
-void sim::init( const scnXml::Scenario& scenario ){
-    SimTime::interval = scenario.getModel().getParameters().getInterval();
+void sim::setOneTS( SimTime ts ){
+    SimTime::interval = ts.inDays();
     SimTime::steps_per_year = SimTime::oneYear().inSteps();
     SimTime::years_per_step = 1.0 / SimTime::steps_per_year;
+}
+
+void sim::init( const scnXml::Scenario& scenario ){
+    scenario_ts = SimTime::fromDays( scenario.getModel().getParameters().getInterval() );
+    setOneTS( scenario_ts );
     sim::max_human_age = SimTime::fromYearsD( scenario.getDemography().getMaximumAgeYrs() );
     if( scenario.getMonitoring().getStartDate().present() ){
         try{
@@ -111,6 +111,92 @@ struct generator_factory {
     }
 } rng;
 
+// -----  sub-streams  -----
+
+// Sub-stream generator: SplitMix64 with a per-stream increment ("gamma"),
+// wrapped as a GSL generator type like the boost generator above. Its state
+// is two words, so seeding it afresh for each SubStream is cheap.
+struct sub_stream_state {
+    uint64_t x, gamma;
+};
+static inline uint64_t mix64 (uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+static inline uint64_t sub_stream_next (void* vstate) {
+    sub_stream_state* state = static_cast<sub_stream_state*>( vstate );
+    state->x += state->gamma;
+    return mix64( state->x );
+}
+static void sub_stream_set (void* vstate, unsigned long int seed) {
+    sub_stream_state* state = static_cast<sub_stream_state*>( vstate );
+    state->x = mix64( seed );
+    state->gamma = 0x9e3779b97f4a7c15ULL;
+}
+static unsigned long int sub_stream_get (void* vstate) {
+    return static_cast<unsigned long int>( sub_stream_next( vstate ) >> 32 );
+}
+static double sub_stream_get_double (void* vstate) {
+    // top 53 bits: a multiple of 2^-53 in [0,1)
+    return static_cast<double>( sub_stream_next( vstate ) >> 11 ) * (1.0 / 9007199254740992.0);
+}
+static const gsl_rng_type sub_stream_type = {
+    "om_sub_stream",		// name
+    0xFFFFFFFFUL,		// max value
+    0,				// min value
+    sizeof(sub_stream_state),	// size of state
+    &sub_stream_set,
+    &sub_stream_get,
+    &sub_stream_get_double
+};
+
+// One sub-stream generator per nesting depth, allocated on first use.
+struct sub_stream_stack {
+    bool enabled;
+    uint64_t seed;      // derived from the scenario's seed
+    size_t depth;
+    vector<gsl_rng*> generators;
+    
+    sub_stream_stack () : enabled(false), seed(0), depth(0) {}
+    ~sub_stream_stack () {
+        for( size_t i = 0; i < generators.size(); ++i )
+            gsl_rng_free( generators[i] );
+    }
+} subStreams;
+
+// The generator all distributions draw from: rng's or a sub-stream's
+static gsl_rng* generator = rng.gsl_generator;
+
+random::SubStream::SubStream( Process process, uint64_t key, uint32_t salt ) :
+    active( subStreams.enabled )
+{
+    if( !active ) return;
+    if( subStreams.depth == subStreams.generators.size() )
+        subStreams.generators.push_back( gsl_rng_alloc( &sub_stream_type ) );
+    generator = subStreams.generators[subStreams.depth];
+    subStreams.depth += 1;
+    
+    uint64_t h = mix64( subStreams.seed ^ static_cast<uint64_t>( process ) );
+    h = mix64( h ^ key );
+    h = mix64( h ^ (static_cast<uint64_t>( salt ) << 32 |
+            static_cast<uint32_t>( sim::nowOrTs0().raw() )) );
+    sub_stream_state* state = static_cast<sub_stream_state*>( gsl_rng_state( generator ) );
+    state->x = h;
+    // As in SplittableRandom: the increment must be odd and not too regular
+    uint64_t gamma = mix64( h ^ 0x9e3779b97f4a7c15ULL ) | 1;
+    int transitions = 0;
+    for( uint64_t t = gamma ^ (gamma >> 1); t != 0; t &= t - 1 ) ++transitions;
+    if( transitions < 24 ) gamma ^= 0xaaaaaaaaaaaaaaaaULL;
+    state->gamma = gamma;
+}
+random::SubStream::~SubStream() {
+    if( !active ) return;
+    subStreams.depth -= 1;
+    generator = subStreams.depth > 0 ?
+        subStreams.generators[subStreams.depth - 1] : rng.gsl_generator;
+}
+
 // -----  set-up, tear-down and checkpointing  -----
 
 void random::seed (uint32_t seed) {
@@ -121,6 +207,11 @@ void random::seed (uint32_t seed) {
 # else
     gsl_rng_set (rng.gsl_generator, seed);
 # endif
+    subStreams.seed = mix64( seed );
+}
+
+void random::enableSubStreams (bool enable) {
+    subStreams.enabled = enable;
 }
 
 void random::checkpoint (istream& stream, int seedFileNumber) {
@@ -136,6 +227,17 @@ void random::checkpoint (istream& stream, int seedFileNumber) {
     istringstream ss (str);
     ss >> boost_generator;
 # else
+    if( seedFileNumber < 0 ){
+        // state is in the stream; read as for boost above
+        size_t len;
+        len & stream;
+        if( len != gsl_rng_size (rng.gsl_generator) )
+            throw checkpoint_error ("random number generator state has wrong size");
+        stream.read (static_cast<char*>(gsl_rng_state (rng.gsl_generator)), len);
+        if (!stream || stream.gcount() != streamsize(len))
+            throw checkpoint_error ("stream read error rng state");
+        return;
+    }
     
     ostringstream seedN;
     seedN << string("seed") << seedFileNumber;
@@ -154,6 +256,12 @@ void random::checkpoint (ostream& stream, int seedFileNumber) {
     ss << boost_generator;
     ss.str() & stream;
 # else
+    if( seedFileNumber < 0 ){
+        size_t len = gsl_rng_size (rng.gsl_generator);
+        len & stream;
+        stream.write (static_cast<const char*>(gsl_rng_state (rng.gsl_generator)), len);
+        return;
+    }
     
     ostringstream seedN;
     seedN << string("seed") << seedFileNumber;
@@ -171,27 +279,28 @@ double random::uniform_01 () {
     double result =
     // GSL and boost versions both do the same (when using boost as the underlying generator):
 # ifdef OM_RANDOM_USE_BOOST
+        generator != rng.gsl_generator ? gsl_rng_uniform (generator) :
         rng_uniform01 ();
 # else
-        gsl_rng_uniform (rng.gsl_generator);
+        gsl_rng_uniform (generator);
 # endif
 //     util::streamValidate(result);
     return result;
 }
 
 double random::gauss (double mean, double std){
-    double result = gsl_ran_gaussian(rng.gsl_generator,std)+mean;
+    double result = gsl_ran_gaussian(generator,std)+mean;
 //     util::streamValidate(result);
     return result;
 }
 double random::gauss (double std){
-    double result = gsl_ran_gaussian(rng.gsl_generator,std);
+    double result = gsl_ran_gaussian(generator,std);
 //     util::streamValidate(result);
     return result;
 }
 
 double random::gamma (double a, double b){
-    double result = gsl_ran_gamma(rng.gsl_generator, a, b);
+    double result = gsl_ran_gamma(generator, a, b);
 //     util::streamValidate(result);
     return result;
 }
@@ -202,7 +311,7 @@ double random::log_normal (double mu, double sigma){
     boost::lognormal_distribution<> dist (mean, std);
     return dist (boost_generator);
 # else*/
-    double result = gsl_ran_lognormal (rng.gsl_generator, mu, sigma);
+    double result = gsl_ran_lognormal (generator, mu, sigma);
 //     util::streamValidate(result);
     return result;
 //# endif
@@ -224,7 +333,7 @@ double random::sampleFromLogNormal(double normp, double meanlog, double stdlog){
 }
 
 double random::beta (double a, double b){
-    double result = gsl_ran_beta (rng.gsl_generator,a,b);
+    double result = gsl_ran_beta (generator,a,b);
 //     util::streamValidate(result);
     return result;
 }
@@ -240,7 +349,7 @@ int random::poisson(double lambda){
 	//This would lead to an inifinite loop in gsl_ran_poisson
 	throw TRACED_EXCEPTION( "lambda is inf", Error::InfLambda );
     }
-    int result = gsl_ran_poisson (rng.gsl_generator, lambda);
+    int result = gsl_ran_poisson (generator, lambda);
 //     util::streamValidate(result);
     return result;
 }
@@ -253,17 +362,28 @@ bool random::bernoulli(double prob){
     return result;
 }
 
+int random::geometric(double prob){
+    assert( prob >= 0.0 && prob <= 1.0 );
+    if( prob >= 1.0 ) return 0;
+    if( prob <= 0.0 ) return numeric_limits<int>::max();
+    // By inversion (gsl_ran_geometric returns an unsigned int, which may
+    // overflow for the small probabilities this is used with). 1-u is in (0,1].
+    double k = floor( log( 1.0 - random::uniform_01() ) / log1p( -prob ) );
+    if( !(k < numeric_limits<int>::max()) ) return numeric_limits<int>::max();
+    return static_cast<int>( k );
+}
+
 int random::uniform(int n){
     assert( (boost::math::isfinite)(n) );
     return static_cast<int>( random::uniform_01() * n );
 }
 
 double random::exponential(double mean){
-    return gsl_ran_exponential(rng.gsl_generator, mean);
+    return gsl_ran_exponential(generator, mean);
 }
 
 double random::weibull(double lambda, double k){
-    return gsl_ran_weibull( rng.gsl_generator, lambda, k );
+    return gsl_ran_weibull( generator, lambda, k );
 }
 
 } }
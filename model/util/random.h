@@ -18,6 +18,9 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+#ifndef Hmod_util_random
+#define Hmod_util_random
+
 #include "Global.h"
 #include <set>
 
@@ -32,10 +35,51 @@ namespace random {
     /// Reseed the random-number-generator with seed (usually InputData.getISeed()).
     void seed (uint32_t seed);
     
+    /** Checkpoint generator state. With GSL the state is written to a
+     * separate file "seedN" where N is seedFileNumber, unless
+     * seedFileNumber is negative, in which case it goes in the stream. */
     void checkpoint (istream& stream, int seedFileNumber);
     void checkpoint (ostream& stream, int seedFileNumber);
+    
+    /** Enable or disable sub-streams (model option COMMON_RANDOM_NUMBERS);
+     * see SubStream. */
+    void enableSubStreams (bool enable);
     //@}
     
+    /** Stochastic processes given separate sub-streams in common random
+     * numbers mode. */
+    enum Process {
+        HOST_INIT,              // heterogeneity sampled at birth
+        INFECTION_INCIDENCE,    // new infections, including imported ones
+        WITHIN_HOST,            // infections, densities, immunity
+        CASE_MANAGEMENT,        // clinical model, including treatment
+        DEPLOYMENT,             // intervention coverage and deployment
+        TRANSMISSION,           // mosquito / transmission model
+        NUM_PROCESSES
+    };
+    
+    /** While an instance exists and sub-streams are enabled, all random
+     * numbers are drawn from a sub-stream identified by the scenario's seed,
+     * the process, key (a human's identifier or 0 for population-level
+     * processes), salt (distinguishes several uses by one process in the
+     * same step) and the current time step. Otherwise it has no effect.
+     * 
+     * Sub-streams are re-seeded on construction, so they have no state to
+     * checkpoint and draws by one process do not depend on how many numbers
+     * other processes drew. Two scenarios differing only in interventions
+     * thus share random numbers wherever the affected processes do not
+     * diverge (common random numbers). Scopes may be nested; the enclosing
+     * sub-stream continues where it left off when an inner scope ends. */
+    class SubStream {
+    public:
+        SubStream( Process process, uint64_t key, uint32_t salt = 0 );
+        ~SubStream();
+    private:
+        SubStream( const SubStream& );      // not copyable
+        void operator=( const SubStream& );
+        bool active;
+    };
+    
     ///@brief Random number distributions
     //@{
     /** Generate a random number in the range [0,1). */
@@ -78,6 +122,11 @@ namespace random {
      * 1-prob (Bernoulli distribution). */
     bool bernoulli(double prob);
     
+    /** Return the number of failures before the first success in a sequence
+     * of Bernoulli trials with probability prob (geometric distribution).
+     * Returns numeric_limits<int>::max() when prob is 0. */
+    int geometric(double prob);
+    
     /** This function returns an integer from 0 to 1-n, where every value has
      * equal probability of being sampled. */
     int uniform (int n);
@@ -96,5 +145,36 @@ namespace random {
      */
     double weibull( double lambda, double k );
     //@}
+    
+    /** Select members of a sequence independently with probability prob.
+     * 
+     * Call next() once for each member, in order; it returns true if the
+     * member is selected. Without skipping this calls bernoulli(prob) for
+     * each member. With skipping, the gap to the next selected member is
+     * sampled from the geometric distribution, so that only one sample is
+     * needed per selected member; the number selected has the same
+     * (binomial) distribution but the random number stream differs. */
+    class BernoulliSequence {
+    public:
+        BernoulliSequence( double prob, bool skip ) :
+            prob(prob), skip(skip), toSkip(skip ? geometric(prob) : 0) {}
+        
+        inline bool next(){
+            if( !skip ) return bernoulli( prob );
+            if( toSkip > 0 ){
+                --toSkip;
+                return false;
+            }
+            toSkip = geometric( prob );
+            return true;
+        }
+        
+    private:
+        double prob;
+        bool skip;
+        int toSkip;     // number of members to skip before the next selection
+    };
 }
 } }
+
+#endif
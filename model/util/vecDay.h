@@ -74,6 +74,11 @@ struct vecDay {
     /// Access
     const vec_t& internal()const{ return v; }
     
+    /// Heap memory used, in bytes
+    inline size_t heapBytes() const{
+        return v.capacity() * sizeof(T);
+    }
+    
     /// Checkpointing
     template<class S>
     void operator& (S& stream) {
@@ -155,6 +160,11 @@ struct vecDay2D {
         return stride;
     }
     
+    /// Heap memory used, in bytes
+    inline size_t heapBytes() const{
+        return v.capacity() * sizeof(T);
+    }
+    
     /// Checkpointing
     template<class S>
     void operator& (S& stream) {
@@ -242,6 +252,11 @@ struct vecDay3D {
         v.assign( v.size(), x );
     }
     
+    /// Heap memory used, in bytes
+    inline size_t heapBytes() const{
+        return v.capacity() * sizeof(T);
+    }
+    
     /// Checkpointing
     template<class S>
     void operator& (S& stream) {
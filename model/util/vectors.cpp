@@ -59,6 +59,26 @@ double vectors::sum (const gsl_vector *vec) {
   return r;
 }
 
+namespace {
+    // step containing day t, rounding down (t may be negative)
+    inline int floorSteps( int t, int stepDays ){
+        int q = t / stepDays;
+        if( t % stepDays < 0 ) q -= 1;
+        return q;
+    }
+}
+vector<size_t> vectors::changeTSIndices( size_t oldLen, SimTime oldTS,
+        size_t newLen, SimTime newTS, SimTime now )
+{
+    vector<size_t> indices( newLen );
+    for( size_t i = 0; i < newLen; ++i ){
+        const int t = now.inDays() - static_cast<int>(i) * newTS.inDays();
+        const int newI = mod( floorSteps( t, newTS.inDays() ), newLen );
+        indices[newI] = mod( floorSteps( t, oldTS.inDays() ), oldLen );
+    }
+    return indices;
+}
+
 void vectors::addTo (vector<double>& x, vector<double>& y){
     assert( x.size() == y.size() );
     for( size_t i=0; i<x.size(); ++i ){
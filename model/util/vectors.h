@@ -60,6 +60,17 @@ namespace vectors {
   void addTo (vector<double>& x, vector<double>& y);
   //@}
   
+  /** For buffers of per-time-step values indexed by time step modulo the
+   * buffer length: map indices after a change of time-step length.
+   * 
+   * Returns a list of length newLen where element i is the index in the old
+   * buffer (length oldLen, steps of oldTS) of the value for the step at index
+   * i under steps of newTS. The newLen latest steps up to and including
+   * time now are mapped; each takes the value of the old step containing it
+   * (i.e. values are assumed constant over each old step). */
+  vector<size_t> changeTSIndices( size_t oldLen, SimTime oldTS,
+        size_t newLen, SimTime newTS, SimTime now );
+  
   
   ///@brief Comparissons on std::vector
   //@{
@@ -142,7 +153,7 @@ struct vector2D {
         const val_t& value = val_t(),
         const alloc_t& a = alloc_t() )
             : stride(n2), v(static_cast<size_t>(n1 * n2), value, a) {}
-    vector2D(const vector2D& x) : stride(x.strid), v(x.v) {}
+    vector2D(const vector2D& x) : stride(x.stride), v(x.v) {}
     
     inline void assign(size_t dim1, size_t dim2, const val_t& val){
         v.assign(dim1 * dim2, val);
@@ -182,6 +193,11 @@ struct vector2D {
         v.assign( v.size(), x );
     }
     
+    /// Heap memory used, in bytes
+    inline size_t heapBytes() const{
+        return v.capacity() * sizeof(T);
+    }
+    
     /// Checkpointing
     template<class S>
     void operator& (S& stream) {
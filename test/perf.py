@@ -0,0 +1,288 @@
+#!/usr/bin/python
+# -*- coding: utf-8 -*-
+
+# This file is part of OpenMalaria.
+#
+# Copyright (C) 2005-2015 Swiss Tropical and Public Health Institute
+# Copyright (C) 2005-2015 Liverpool School Of Tropical Medicine
+#
+# OpenMalaria is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or (at
+# your option) any later version.
+#
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+# Performance counterpart of run.py: runs scenarios (optionally with scaled
+# population size), with checkpointing, and records wall time, peak RSS,
+# human updates per second and checkpoint size and read/write times. These are
+# compared against a baseline file; a figure worse than the baseline by more
+# than its tolerance fails the test.
+#
+# Baselines are machine-specific; create one with --update-baseline.
+# Exit status:
+#	0 - all scenarios within tolerance (or no baseline)
+#	1 - a regression was found, or openMalaria failed
+#	-1 - unable to run test
+
+import sys
+import os
+import re
+import glob
+import time
+import shutil
+import tempfile
+import subprocess
+from optparse import OptionParser
+
+class RunError(Exception):
+    def __init__(self, value):
+        self.value = value
+    def __str__(self):
+        return repr(self.value)
+
+# replaced by CMake; run the version it puts in the build/test/ dir.
+testSrcDir="@CMAKE_CURRENT_SOURCE_DIR@"
+testBuildDir="@CMAKE_CURRENT_BINARY_DIR@"
+if not os.path.isdir(testSrcDir) or not os.path.isdir(testBuildDir):
+    print "Don't run this script directly; configure CMake then use the version in the CMake build dir."
+    sys.exit(-1)
+
+def findExec (*names):
+    newest=None
+    for name in names:
+        path=os.path.join(testBuildDir,name)
+        if os.path.isfile(path) and (newest is None or os.path.getmtime(path) > os.path.getmtime(newest)):
+            newest=path
+    if newest is None:
+        raise RunError("Unable to find: openMalaria[.exe]; please compile it.")
+    return os.path.abspath(newest)
+
+# Metrics: name -> (True if higher is worse, default relative tolerance,
+# absolute slack). The slack stops tiny timings failing on noise.
+METRICS = {
+    "wall_s" : (True, 0.25, 0.5),
+    "peak_rss_kb" : (True, 0.10, 1024),
+    "human_updates_per_s" : (False, 0.25, 0.0),
+    "checkpoint_bytes" : (True, 0.05, 0),
+    "checkpoint_write_s" : (True, 0.5, 0.05),
+    "checkpoint_read_s" : (True, 0.5, 0.05),
+}
+
+def readBaseline (path):
+    """Read a baseline: lines of 'scenario scale metric value [tolerance]'."""
+    baseline = {}
+    if not os.path.isfile(path):
+        return baseline
+    for line in open(path):
+        line = line.split('#')[0].split()
+        if not line:
+            continue
+        if len(line) < 4:
+            raise RunError("%s: bad line: %s" % (path, " ".join(line)))
+        tol = float(line[4]) if len(line) > 4 else None
+        baseline[(line[0], float(line[1]), line[2])] = (float(line[3]), tol)
+    return baseline
+
+def writeBaseline (path, baseline):
+    f = open(path, 'w')
+    f.write("# OpenMalaria performance baseline (see test/perf.py); machine-specific.\n")
+    f.write("# scenario\tscale\tmetric\tvalue\t[relative tolerance]\n")
+    for key in sorted(baseline.keys()):
+        value, tol = baseline[key]
+        f.write("%s\t%g\t%s\t%r" % (key[0], key[1], key[2], value))
+        if tol is not None:
+            f.write("\t%g" % tol)
+        f.write("\n")
+    f.close()
+
+def scaleScenario (src, dest, scale):
+    text = open(src).read()
+    def repl (m):
+        return 'popSize="%d"' % max(1, int(round(int(m.group(1)) * scale)))
+    text, n = re.subn(r'popSize="(\d+)"', repl, text, count=1)
+    if n != 1:
+        raise RunError("%s: no popSize attribute" % src)
+    open(dest, 'w').write(text)
+
+def runOnce (cmd, cwd, stderrPath):
+    """Run cmd; return (exit status, peak RSS in KiB or None)."""
+    errFile = open(stderrPath, 'a')
+    devnull = open(os.devnull, 'w')
+    proc = subprocess.Popen(cmd, shell=False, cwd=cwd, stdout=devnull, stderr=errFile)
+    rss = None
+    if hasattr(os, 'wait4'):
+        pid, status, usage = os.wait4(proc.pid, 0)
+        ret = os.WEXITSTATUS(status) if os.WIFEXITED(status) else -1
+        rss = usage.ru_maxrss
+        if sys.platform == 'darwin':
+            rss /= 1024     # bytes on OS X
+    else:
+        ret = proc.wait()
+    errFile.close()
+    devnull.close()
+    return ret, rss
+
+def measureScenario (options, omOptions, name):
+    scenarioSrc=os.path.abspath(os.path.join(testSrcDir,"scenario%s.xml" % name))
+    if not os.path.isfile(scenarioSrc):
+        raise RunError('No such scenario file '+scenarioSrc)
+
+    simDir = tempfile.mkdtemp(prefix=name+'-perf-', dir=testBuildDir)
+    scenarioFile = os.path.join(simDir, "scenario.xml")
+    scaleScenario(scenarioSrc, scenarioFile, options.scale)
+    # The scenario is opened by path, so the schema must be alongside it
+    # (scenario_current.xsd is generated in the build dir):
+    for schemaDir in (os.path.join(testSrcDir,'../schema'), os.path.join(testBuildDir,'../schema')):
+        for xsd in glob.glob(os.path.join(schemaDir,'*.xsd')):
+            shutil.copy2(xsd, simDir)
+    stderrPath = os.path.join(simDir, "stderr.txt")
+    outputFile = os.path.join(simDir, "output.txt")
+    checkFile = os.path.join(simDir, "checkpoint")
+
+    cmd = [openMalariaExec, "--resource-path", os.path.abspath(testSrcDir),
+           "--scenario", scenarioFile, "--checkpoint", "--perf-stats"] + omOptions
+
+    wall = 0.0
+    rss = None
+    lastTime = time.time()
+    while not os.path.isfile(outputFile) and not os.path.isfile(outputFile+".gz"):
+        start = time.time()
+        ret, runRss = runOnce(cmd, simDir, stderrPath)
+        wall += time.time() - start
+        if runRss is not None:
+            rss = max(rss, runRss)
+        if ret != 0:
+            raise RunError("%s: non-zero exit status %d (see %s)" % (name, ret, stderrPath))
+        if not os.path.isfile(checkFile) or not os.path.getmtime(checkFile) > lastTime:
+            break
+        lastTime = os.path.getmtime(checkFile)
+
+    results = { "wall_s" : wall }
+    if rss is not None:
+        results["peak_rss_kb"] = rss
+    writeTimes = []
+    readTimes = []
+    for line in open(stderrPath):
+        fields = line.split()
+        if len(fields) != 3 or fields[0] != "perf":
+            continue
+        if fields[1] == "checkpoint_write_s":
+            writeTimes.append(float(fields[2]))
+        elif fields[1] == "checkpoint_read_s":
+            readTimes.append(float(fields[2]))
+        elif fields[1] == "checkpoint_bytes":
+            results["checkpoint_bytes"] = max(results.get("checkpoint_bytes", 0), int(fields[2]))
+        elif fields[1] == "human_updates":
+            results["human_updates_per_s"] = int(fields[2]) / max(wall, 1e-6)
+    if writeTimes:
+        results["checkpoint_write_s"] = max(writeTimes)
+    if readTimes:
+        results["checkpoint_read_s"] = max(readTimes)
+
+    if options.cleanup:
+        shutil.rmtree(simDir, ignore_errors=True)
+    return results
+
+def compare (name, scale, results, baseline, options):
+    """Print results and return the number of regressions."""
+    regressions = 0
+    for metric in sorted(results.keys()):
+        value = results[metric]
+        higherWorse, defTol, slack = METRICS[metric]
+        key = (name, scale, metric)
+        if key not in baseline:
+            status = "no baseline"
+        else:
+            base, tol = baseline[key]
+            if tol is None:
+                tol = defTol * options.toleranceFactor
+            if higherWorse:
+                bad = value > base * (1.0 + tol) + slack
+            else:
+                bad = value < base * (1.0 - tol) - slack
+            change = (value - base) / base * 100.0 if base != 0 else 0.0
+            status = "%+.1f%% vs %g" % (change, base)
+            if bad:
+                status = "\033[1;31mREGRESSION " + status + "\033[0;00m"
+                regressions += 1
+        if options.logging:
+            print "  %-22s %14.6g  %s" % (metric, value, status)
+    return regressions
+
+def evalOptions (args):
+    #First separate OpenMalaria args and args for this script
+    omArgsBegin = len(args)
+    for i in range(0,len(args)-1):
+        if args[i] == "--":
+            omArgsBegin = i+1
+            break
+    omOptions=args[omArgsBegin:]
+    args = args[:omArgsBegin]
+
+    parser = OptionParser(usage="Usage: %prog [options] [scenarios] [-- openMalaria options]",
+            description="""Measure performance of scenarios scenarioXX.xml from the OM_BASE/test directory (all if none are named) and compare with a baseline.""")
+    parser.add_option("-q","--quiet",
+            action="store_false", dest="logging", default=True,
+            help="Turn off console output from this script")
+    parser.add_option("-c","--dont-cleanup", action="store_false", dest="cleanup", default=True,
+            help="Don't delete the temporary run directory")
+    parser.add_option("-s","--scale", type="float", dest="scale", default=1.0,
+            help="Multiply the population size of each scenario by this (default: 1)")
+    parser.add_option("-b","--baseline", dest="baseline",
+            default=os.path.join(testBuildDir,"perf-baseline.txt"),
+            help="Baseline file (default: perf-baseline.txt in the build test directory)")
+    parser.add_option("-u","--update-baseline", action="store_true", dest="update", default=False,
+            help="Write results to the baseline file instead of comparing")
+    parser.add_option("-t","--tolerance-factor", type="float", dest="toleranceFactor", default=1.0,
+            help="Multiply default tolerances by this (tolerances given in the baseline file are not affected)")
+    (options, others) = parser.parse_args(args=args)
+    return options,omOptions,set(others)
+
+def main(args):
+    try:
+        (options,omOptions,toRun) = evalOptions (args[1:])
+        global openMalariaExec
+        openMalariaExec = findExec("../openMalaria", "../Debug/openMalaria", "../Release/openMalaria",
+                "../openMalaria.exe", "../Debug/openMalaria.exe", "../Release/openMalaria.exe",
+                "../RelWithDebInfo/openMalaria.exe")
+
+        if not toRun:
+            for p in glob.iglob(os.path.join(testSrcDir,"scenario*.xml")):
+                toRun.add(os.path.basename(p)[8:-4])
+
+        baseline = readBaseline(options.baseline)
+        retVal = 0
+        for name in sorted(toRun):
+            if options.logging:
+                print "\033[1;33m%s\033[0;00m (population scale %g)" % (name, options.scale)
+            try:
+                results = measureScenario(options, omOptions, name)
+            except RunError,e:
+                print "\033[1;31m" + str(e) + "\033[0;00m"
+                retVal = 1
+                continue
+            if options.update:
+                for metric, value in results.iteritems():
+                    old = baseline.get((name, options.scale, metric), (None, None))
+                    baseline[(name, options.scale, metric)] = (value, old[1])
+                compare(name, options.scale, results, {}, options)
+            elif compare(name, options.scale, results, baseline, options) > 0:
+                retVal = 1
+
+        if options.update:
+            writeBaseline(options.baseline, baseline)
+        return retVal
+    except RunError,e:
+        print str(e)
+        return -1
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -33,6 +33,7 @@ import glob
 import time
 import subprocess
 import shutil
+import copy
 from optparse import OptionParser
 import gzip
 
@@ -111,6 +112,19 @@ def linkOrCopy (src, dest):
     else:
         shutil.copy2(src, dest)
 
+# Write a copy of scenario file src to dest with the given model options on
+def generateScenario(src,modelOptions,dest):
+    f=open(src,'r')
+    text=f.read()
+    f.close()
+    pos=text.find("</ModelOptions>")
+    if pos < 0:
+        raise RunError("no ModelOptions element in "+src)
+    insert="".join(['  <option name="%s" value="true"/>\n    ' % opt for opt in modelOptions])
+    f=open(dest,'w')
+    f.write(text[:pos]+insert+text[pos:])
+    f.close()
+
 # Run, with file "scenario"+name+".xml" (or just "name")
 def runScenario(options,omOptions,name):
     scenarioSrc=os.path.abspath(os.path.join(testSrcDir,"scenario%s.xml" % name))
@@ -123,6 +137,14 @@ def runScenario(options,omOptions,name):
             compare=False
         else:
             raise RunError('No such scenario file '+scenarioSrc+' or '+name+'!')
+    # outputs are compared with those of the unmodified scenario
+    expectedName=tmpprefix
+    generatedSrc=None
+    if options.modelOptions:
+        tmpprefix=tmpprefix+'-'+'-'.join(options.modelOptions)
+        generatedSrc=os.path.join(testBuildDir,"scenario%s.xml" % tmpprefix)
+        generateScenario(scenarioSrc,options.modelOptions,generatedSrc)
+        scenarioSrc=generatedSrc
     schemaName=getSchemaName(scenarioSrc)
     scenarioSchema=os.path.abspath(os.path.join(testSrcDir,'../schema',schemaName))
     if not os.path.isfile(scenarioSchema):
@@ -201,13 +223,15 @@ def runScenario(options,omOptions,name):
     
     if options.cleanup:
         os.remove(scenario_xsd)
+        if generatedSrc is not None:
+            os.remove(generatedSrc)
         for f in (glob.glob(os.path.join(simDir,"checkpoint*")) + glob.glob(os.path.join(simDir,"seed?")) + [os.path.join(simDir,"init_data.xml"),os.path.join(simDir,"boinc_finish_called"),os.path.join(simDir,"scenario.sum")]):
             if os.path.isfile(f):
                 os.remove(f)
     
-    origCtsout = os.path.join(testSrcDir,"expected/ctsout%s.txt"%tmpprefix)
+    origCtsout = os.path.join(options.expectedDir,"ctsout%s.txt"%expectedName)
     newCtsout = os.path.join(testBuildDir,"ctsout%s.txt"%tmpprefix)
-    origOutput = os.path.join(testSrcDir,"expected/output%s.txt"%tmpprefix)
+    origOutput = os.path.join(options.expectedDir,"output%s.txt"%expectedName)
     newOutput = os.path.join(testBuildDir,"output%s.txt"%tmpprefix)
     haveCtsOut = os.path.isfile(ctsoutFile)
     haveMainOut = os.path.isfile(outputFile)
@@ -215,7 +239,10 @@ def runScenario(options,omOptions,name):
     # Compare outputs:
     if ret == 0 and compare:
         # ctsout.txt (this output is optional):
-        if haveCtsOut:
+        if haveCtsOut and options.tolerance is not None:
+            print "ctsout.txt not compared (--tolerance)"
+            ctsret,ctsident = 0,False
+        elif haveCtsOut:
             if os.path.isfile(origCtsout):
                 ctsret,ctsident = compareCtsout.main (origCtsout, ctsoutFile)
             else:
@@ -231,7 +258,9 @@ def runScenario(options,omOptions,name):
         
         # output.txt (this output is required):
         if haveMainOut:
-            if os.path.isfile(origOutput):
+            if os.path.isfile(origOutput) and options.tolerance is not None:
+                ret,ident = compareOutput.compareTotals (origOutput, outputFile, options.tolerance)
+            elif os.path.isfile(origOutput):
                 ret,ident = compareOutput.main (origOutput, outputFile, 0)
             else:
                 ret,ident = 3,False
@@ -272,6 +301,30 @@ def runScenario(options,omOptions,name):
     print "\033[0;00m"
     return ret
 
+# Run name without omOptions, then with them, comparing outputs of the second
+# run with those of the first instead of with expected outputs. This tests
+# options which should not change results (e.g. --checkpoint) on scenarios
+# without expected outputs (e.g. those generated with --model-option).
+def runSelfCompare(options,omOptions,name):
+    refDir = tempfile.mkdtemp(prefix=name+'-ref-', dir=testBuildDir)
+    refOptions = copy.copy(options)
+    refOptions.compare = False
+    ret = runScenario(refOptions,[],name)
+    if ret != 0:
+        return ret
+    prefix = "-".join([name]+options.modelOptions)
+    for f in ["output%s.txt", "ctsout%s.txt"]:
+        path = os.path.join(testBuildDir,f%prefix)
+        if os.path.isfile(path):
+            shutil.move(path, os.path.join(refDir,f%name))
+    
+    cmpOptions = copy.copy(options)
+    cmpOptions.expectedDir = refDir
+    ret = runScenario(cmpOptions,omOptions,name)
+    if options.cleanup:
+        shutil.rmtree(refDir)
+    return ret
+
 def setWrapArgs(option, opt_str, value, parser, *args, **kwargs):
     parser.values.wrapArgs = args[0]
 
@@ -299,8 +352,14 @@ You can pass options to openMalaria by first specifying -- (to end options passe
 		    help="Don't clean up expected files from the temparary dir (checkpoint files, schema, etc.)")
     parser.add_option("-C","--no-compare", action="store_false", dest="compare", default=True,
                       help="Don't compare output after running; instead just copy outputs to test/outputXX.txt and test/ctsoutXX.txt")
+    parser.add_option("-s","--self-compare", action="store_true", dest="selfCompare", default=False,
+                      help="Compare output with that of a run without the openMalaria options given (e.g. --checkpoint) instead of with expected outputs")
     parser.add_option("-d","--diff", action="store_true", dest="diff", default=False,
             help="Launch a diff program (kdiff3) on the output if validation fails")
+    parser.add_option("-m","--model-option", action="append", dest="modelOptions", default=[],
+                      help="Run a copy of the scenario with this model option turned on (may be repeated); outputs are compared with those expected of the unmodified scenario")
+    parser.add_option("-t","--tolerance", action="store", dest="tolerance", type="float", default=None,
+                      help="Only compare per-measure totals of output.txt, with this relative tolerance (for statistically equivalent runs, e.g. with --model-option)")
     parser.add_option("--valid","--validate",
 		    action="store_true", dest="xmlValidate", default=False,
 		    help="Validate the XML file(s) using xmllint and the latest schema.")
@@ -322,6 +381,7 @@ You can pass options to openMalaria by first specifying -- (to end options passe
     (options, others) = parser.parse_args(args=args)
     
     options.ensure_value("wrapArgs", [])
+    options.ensure_value("expectedDir", os.path.join(testSrcDir,"expected"))
     
     toRun=set()
     for arg in others:
@@ -343,7 +403,10 @@ def main(args):
         
         retVal=0
         for name in toRun:
-            r=runScenario(options,omOptions,name)
+            if options.selfCompare:
+                r=runSelfCompare(options,omOptions,name)
+            else:
+                r=runScenario(options,omOptions,name)
             retVal = r if retVal == 0 else retVal
         
         return retVal
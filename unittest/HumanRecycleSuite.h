@@ -0,0 +1,95 @@
+/*
+ This file is part of OpenMalaria.
+
+ Copyright (C) 2005-2015 Swiss Tropical and Public Health Institute
+ Copyright (C) 2005-2015 Liverpool School Of Tropical Medicine
+
+ OpenMalaria is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or (at
+ your option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+// Unittest: a recycled Human (Human::retire() then reset()) must be
+// indistinguishable from a newly constructed one
+
+#ifndef Hmod_HumanRecycleSuite
+#define Hmod_HumanRecycleSuite
+
+#include <cxxtest/TestSuite.h>
+#include "configured/TestPaths.h"
+#include "ModelFixture.h"
+#include "Clinical/ClinicalModel.h"
+#include "util/random.h"
+#include <sstream>
+
+using namespace OM;
+
+/** Loads whole scenarios (from test/) since a Human's sub-models depend on
+ * most of the static model state. Should be run after other suites: it
+ * replaces and then frees all static model state. */
+class HumanRecycleSuite : public CxxTest::TestSuite
+{
+public:
+    void tearDown () {
+        fixture.reset();
+    }
+
+    // descriptive within-host and 5-day clinical models, non-vector
+    void testDescriptive () {
+        checkRecycled( "1" );
+    }
+    // vector model: per-species heterogeneity in Transmission::PerHost
+    void testVector () {
+        checkRecycled( "VecTest" );
+    }
+    // Molineaux within-host, PK/PD and event-scheduler clinical models
+    void testEventScheduler () {
+        checkRecycled( "ESTS" );
+    }
+    void testVivax () {
+        checkRecycled( "Vivax" );
+    }
+
+private:
+    static string checkpoint( Host::Human& human ){
+        ostringstream stream;
+        ostream& os( stream );
+        human & os;
+        return stream.str();
+    }
+
+    /** Use an initial human for a while, recycle it as a newborn and compare
+     * against a newborn constructed with the same random numbers. */
+    void checkRecycled( const string& name ){
+        fixture.reset( new ModelFixture( string(UnittestSourceDir) + "../test/scenario" + name + ".xml" ) );
+        Host::Human& human = *sim::humanPop().begin();
+        for( int i = 0; i < 30; ++i ){
+            if( human.update( true ) ) break;       // died
+            ModelFixture::nextStep();
+        }
+        human.retire();
+
+        const SimTime dob = sim::nowOrTs1();
+        util::random::seed( 7 );
+        Host::Human fresh( dob, 2u );
+        util::random::seed( 7 );
+        human.reset( dob, 2u );
+
+        TS_ASSERT_EQUALS( checkpoint( human ), checkpoint( fresh ) );
+        TS_ASSERT_EQUALS( human.getID(), fresh.getID() );
+        fresh.destroy();
+    }
+
+    unique_ptr<ModelFixture> fixture;
+};
+
+#endif
@@ -50,6 +50,16 @@ public:
 	TS_ASSERT_APPROX (infection->immunitySurvivalFactor (100., 100., 1e8), 0.17081918453312689);
     }
     
+    void testHostImmunity () {
+	// precomputed host terms must give exactly the same result
+	const double cases[4][3] = { {100.,0.,0.}, {0.1,0.,0.}, {100.,100.,0.}, {100.,100.,1e8} };
+	for( int i = 0; i < 4; ++i ){
+	    Infection::HostImmunity host = Infection::hostImmunity (cases[i][0], cases[i][1], cases[i][2]);
+	    TS_ASSERT_EQUALS (infection->immunitySurvivalFactor (host),
+			      infection->immunitySurvivalFactor (cases[i][0], cases[i][1], cases[i][2]));
+	}
+    }
+    
 private:
     DummyInfection* infection;
 };
@@ -92,6 +92,22 @@ public:
 	TS_ASSERT_APPROX (proxy->getDrugFactor (inf, massAt21), 0.03174563637686205);
     }
     
+    void testCleared () {
+	TS_ASSERT( proxy->isIdle() );
+	UnittestUtil::medicate( *proxy, MQ_index, 3000, 0, massAt21 );
+	TS_ASSERT( !proxy->isIdle() );
+	int days = 0;
+	while( !proxy->isIdle() && days < 365 ){
+	    proxy->decayDrugs (massAt21);
+	    days += 1;
+	}
+	// about 9 half-lives (13 days each) to fall below negligible concentration
+	TS_ASSERT( proxy->isIdle() );
+	TS_ASSERT_LESS_THAN( 100, days );
+	TS_ASSERT_LESS_THAN( days, 140 );
+	TS_ASSERT_EQUALS( proxy->getDrugConc( MQ_index ), 0.0 );
+    }
+    
 private:
     LSTMModel *proxy;
     CommonInfection *inf;
@@ -0,0 +1,110 @@
+/*
+ This file is part of OpenMalaria.
+
+ Copyright (C) 2005-2015 Swiss Tropical and Public Health Institute
+ Copyright (C) 2005-2015 Liverpool School Of Tropical Medicine
+
+ OpenMalaria is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or (at
+ your option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+// Whole-model fixture for unittests and benchmarks: loads a scenario file and
+// sets up the simulator and its initial population.
+
+#ifndef Hmod_ModelFixture
+#define Hmod_ModelFixture
+
+#include "Global.h"
+#include "Simulator.h"
+#include "Population.h"
+#include "Host/Human.h"
+#include "Transmission/VectorModel.h"
+#include "WithinHost/WHInterface.h"
+#include "util/BoincWrapper.h"
+#include "util/errors.h"
+
+#include "schema/scenario.h"
+
+#include <fstream>
+
+using namespace OM;
+
+/** Constructs a Simulator and the initial population as Simulator::start()
+ * does before its first step (no warm-up is run), then begins an update of
+ * the first step.
+ *
+ * Model state is static, so only one instance may exist at a time; the
+ * destructor frees all static model state. */
+class ModelFixture {
+public:
+    /** Load scenario file (without validation).
+     *
+     * @param popSize If greater than zero, replaces the scenario's population size */
+    explicit ModelFixture( const string& file, int popSize = 0 ){
+        ifstream stream( file.c_str(), ios::binary );
+        if( !stream.good() )
+            throw util::xml_scenario_error( "unable to open " + file );
+        scenario = scnXml::parseScenario( stream, xml_schema::Flags::dont_validate );
+        util::Checksum cksum = util::Checksum::generate( stream );
+        stream.close();
+        if( popSize > 0 )
+            scenario->getDemography().setPopSize( popSize );
+
+        simulator.reset( new Simulator( cksum, *scenario ) );
+        sim::time0 = SimTime::zero();
+        sim::time1 = SimTime::zero();
+        // no placeholders: all humans may be updated
+        sim::humanPop().createInitialHumans( SimTime::zero() );
+        sim::transmission().init2();
+        sim::start_update();
+    }
+    ~ModelFixture(){
+        simulator.reset();
+        Simulator::clearStatic();
+    }
+
+    /// Move on to the update of the next step.
+    static void nextStep(){
+        sim::end_update();
+        sim::start_update();
+    }
+    /// Within-host update of one human (as in Human::update) with no vaccine.
+    static void updateWithinHost( Host::Human& human, int nNewInfs,
+                                  vector<double>& genotype_weights ){
+        human.withinHostModel->update( nNewInfs, genotype_weights,
+                human.age(sim::ts1()).inYears(), 1.0 );
+    }
+    /** Run AnophelesModel::advancePeriod (thus MosqTransmission::update for
+     * each day of the step) for one species, using the population sums saved
+     * by the last VectorModel::vectorUpdate(). */
+    static void advanceVectorSpecies( size_t s ){
+        Transmission::VectorModel& vm =
+            dynamic_cast<Transmission::VectorModel&>( sim::transmission() );
+        SimTime ind = mod_nn( sim::ts0(), vm.saved_sum_avail.size1() );
+        typedef vector<double>::const_iterator const_iter_t;
+        std::pair<const_iter_t, const_iter_t> range = vm.saved_sigma_dif.range_at12( ind, s );
+        vector<double> sigma_dif( range.first, range.second );
+        // sigma_dff isn't saved; it equals sigma_df without fecundity effects
+        vm.species[s].advancePeriod( vm.saved_sum_avail.at( ind, s ),
+                vm.saved_sigma_df.at( ind, s ), sigma_dif,
+                vm.saved_sigma_df.at( ind, s ),
+                vm.simulationMode == Transmission::dynamicEIR );
+    }
+
+private:
+    unique_ptr<scnXml::Scenario> scenario;
+    unique_ptr<Simulator> simulator;
+};
+
+#endif
@@ -26,6 +26,7 @@
 #include <cxxtest/TestSuite.h>
 #include <boost/format.hpp>
 #include "PkPd/LSTMModel.h"
+#include "PkPd/Drug/LSTMDrugThreeComp.h"
 #include "WithinHost/Infection/DummyInfection.h"
 #include "UnittestUtil.h"
 #include "ExtraAsserts.h"
@@ -331,6 +332,22 @@ public:
         runDrugSimulations("PPQ3", drug_conc, drug_factors);
     }
     
+    // As above, using Gauss-Legendre integration of the killing function
+    void testPPQ_Hodel2013_GL (){
+        LSTMDrugType::clear();
+        UnittestUtil::PkPdSuiteSetup(true);
+        LSTMDrugThreeComp::gaussLegendreIntegrals = 0;
+        testPPQ_Hodel2013();
+        TS_ASSERT_LESS_THAN( 0u, LSTMDrugThreeComp::gaussLegendreIntegrals );
+    }
+    void testPPQ_Tarning2012AAC_GL (){
+        LSTMDrugType::clear();
+        UnittestUtil::PkPdSuiteSetup(true);
+        LSTMDrugThreeComp::gaussLegendreIntegrals = 0;
+        testPPQ_Tarning2012AAC();
+        TS_ASSERT_LESS_THAN( 0u, LSTMDrugThreeComp::gaussLegendreIntegrals );
+    }
+    
 private:
     LSTMModel *proxy;
     CommonInfection *inf;
@@ -0,0 +1,166 @@
+/*
+ This file is part of OpenMalaria.
+ 
+ Copyright (C) 2005-2015 Swiss Tropical and Public Health Institute
+ Copyright (C) 2005-2015 Liverpool School Of Tropical Medicine
+ 
+ OpenMalaria is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or (at
+ your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+#ifndef Hmod_RandomSuite
+#define Hmod_RandomSuite
+
+#include <cxxtest/TestSuite.h>
+#include "UnittestUtil.h"
+#include "ExtraAsserts.h"
+
+#include "util/random.h"
+#include <limits>
+#include <vector>
+
+using namespace OM::util;
+
+class RandomSuite : public CxxTest::TestSuite
+{
+public:
+    void setUp() {
+        UnittestUtil::initTime( 5 );
+        random::seed( 83 );
+    }
+    void tearDown() {
+        random::enableSubStreams( false );
+    }
+    
+    void testGeometricBounds() {
+        for( int i = 0; i < 10; ++i ){
+            TS_ASSERT_EQUALS( random::geometric( 1.0 ), 0 );
+            TS_ASSERT_EQUALS( random::geometric( 0.0 ), std::numeric_limits<int>::max() );
+        }
+    }
+    
+    void testGeometricMoments() {
+        // failures before first success: mean (1-p)/p, variance (1-p)/p²
+        const double p = 0.05;
+        const int N = 100000;
+        double sum = 0.0, sumSq = 0.0;
+        for( int i = 0; i < N; ++i ){
+            double k = random::geometric( p );
+            sum += k;
+            sumSq += k * k;
+        }
+        double mean = sum / N;
+        double var = sumSq / N - mean * mean;
+        TS_ASSERT_APPROX_TOL( mean, (1.0 - p) / p, 0.02, 0.0 );
+        TS_ASSERT_APPROX_TOL( var, (1.0 - p) / (p * p), 0.05, 0.0 );
+    }
+    
+    void testBernoulliSequenceSkip() {
+        // The number selected from n members has the same (binomial)
+        // distribution with and without skipping.
+        const double p = 0.1;
+        const int n = 50, N = 20000, maxK = 16;
+        std::vector<double> freq[2];
+        for( int skip = 0; skip < 2; ++skip ){
+            freq[skip].assign( maxK + 1, 0.0 );
+            double sum = 0.0, sumSq = 0.0;
+            for( int i = 0; i < N; ++i ){
+                random::BernoulliSequence seq( p, skip );
+                int k = 0;
+                for( int j = 0; j < n; ++j ){
+                    if( seq.next() ) ++k;
+                }
+                sum += k;
+                sumSq += k * k;
+                freq[skip][std::min( k, maxK )] += 1.0 / N;
+            }
+            double mean = sum / N;
+            TS_ASSERT_APPROX_TOL( mean, n * p, 0.02, 0.0 );
+            TS_ASSERT_APPROX_TOL( sumSq / N - mean * mean, n * p * (1.0 - p), 0.05, 0.0 );
+        }
+        for( int k = 0; k <= maxK; ++k ){
+            TS_ASSERT_DELTA( freq[0][k], freq[1][k], 0.015 );
+        }
+    }
+    
+    void testSubStreamDisabled() {
+        // Without COMMON_RANDOM_NUMBERS sub-streams have no effect
+        random::enableSubStreams( false );
+        double x[3];
+        x[0] = random::uniform_01();
+        {
+            random::SubStream stream( random::WITHIN_HOST, 7 );
+            x[1] = random::uniform_01();
+        }
+        x[2] = random::uniform_01();
+        random::seed( 83 );
+        for( int i = 0; i < 3; ++i ){
+            TS_ASSERT_EQUALS( random::uniform_01(), x[i] );
+        }
+    }
+    
+    void testSubStreamReproducible() {
+        random::enableSubStreams( true );
+        const double x = draw( random::WITHIN_HOST, 7, 2 );
+        random::uniform_01();   // main stream state doesn't matter
+        TS_ASSERT_EQUALS( draw( random::WITHIN_HOST, 7, 2 ), x );
+        random::seed( 83 );
+        TS_ASSERT_EQUALS( draw( random::WITHIN_HOST, 7, 2 ), x );
+        
+        // any difference in seed, process, key, salt or time gives another stream
+        TS_ASSERT_DIFFERS( draw( random::CASE_MANAGEMENT, 7, 2 ), x );
+        TS_ASSERT_DIFFERS( draw( random::WITHIN_HOST, 8, 2 ), x );
+        TS_ASSERT_DIFFERS( draw( random::WITHIN_HOST, 7, 3 ), x );
+        TS_ASSERT_DIFFERS( draw( random::WITHIN_HOST, uint64_t(7) << 32, 2 ), x );
+        UnittestUtil::incrTime( SimTime::oneTS() );
+        TS_ASSERT_DIFFERS( draw( random::WITHIN_HOST, 7, 2 ), x );
+        UnittestUtil::initTime( 5 );
+        random::seed( 84 );
+        TS_ASSERT_DIFFERS( draw( random::WITHIN_HOST, 7, 2 ), x );
+    }
+    
+    void testSubStreamNesting() {
+        random::enableSubStreams( true );
+        double x[3];
+        {
+            random::SubStream outer( random::HOST_INIT, 1 );
+            x[0] = random::uniform_01();
+            x[1] = random::uniform_01();
+        }
+        x[2] = random::uniform_01();
+        
+        // an inner scope does not change draws from the outer sub-stream or
+        // the main stream
+        random::seed( 83 );
+        {
+            random::SubStream outer( random::HOST_INIT, 1 );
+            TS_ASSERT_EQUALS( random::uniform_01(), x[0] );
+            {
+                random::SubStream inner( random::WITHIN_HOST, 1 );
+                TS_ASSERT_DIFFERS( random::uniform_01(), x[1] );
+                random::uniform_01();
+            }
+            TS_ASSERT_EQUALS( random::uniform_01(), x[1] );
+        }
+        TS_ASSERT_EQUALS( random::uniform_01(), x[2] );
+    }
+    
+private:
+    double draw( random::Process process, uint64_t key, uint32_t salt ){
+        random::SubStream stream( process, key, salt );
+        return random::uniform_01();
+    }
+};
+
+#endif
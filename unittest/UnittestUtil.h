@@ -312,8 +312,9 @@ public:
         diagnostics::init( parameters, dummyXML::scenario );
     }
     
-    static void PkPdSuiteSetup () {
+    static void PkPdSuiteSetup (bool gaussLegendre = false) {
         ModelOptions::reset();
+        if( gaussLegendre ) ModelOptions::set(util::LSTM_PKPD_GAUSS_LEGENDRE);
         WithinHost::Genotypes::initSingle();
 
         //Note: we fudge this call since it's not so easy to falsely initialize scenario element.
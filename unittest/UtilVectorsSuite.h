@@ -49,6 +49,22 @@ public:
         for( size_t i=0; i<result.internal().size(); ++i )
             TS_ASSERT_APPROX( input[i], result[SimTime::fromDays(i)] );
     }
+
+    void testChangeTSIndices() {
+        // 5-day steps over 20 days to 1-day steps: each old value repeated
+        vector<size_t> fine = vectors::changeTSIndices( 4, SimTime::fromDays(5),
+                20, SimTime::oneDay(), SimTime::fromDays(100) );
+        ETS_ASSERT_EQUALS( fine.size(), 20u );
+        for( size_t i = 0; i < fine.size(); ++i )
+            TS_ASSERT_EQUALS( fine[i], i / 5 );
+
+        // and back, at a time not a multiple of the buffer length
+        vector<size_t> coarse = vectors::changeTSIndices( 20, SimTime::oneDay(),
+                4, SimTime::fromDays(5), SimTime::fromDays(105) );
+        ETS_ASSERT_EQUALS( coarse.size(), 4u );
+        for( size_t i = 0; i < coarse.size(); ++i )
+            TS_ASSERT_EQUALS( coarse[i], i * 5 );
+    }
 };
 
 #endif
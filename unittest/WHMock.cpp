@@ -43,6 +43,9 @@ double WHMock::pTransGenotype( double, double, size_t ){
 bool WHMock::summarize(const Host::Human& human)const{
     throw util::unimplemented_exception( "not needed in unit test" );
 }
+void WHMock::memoryStats( util::MemoryStats& stats )const{
+    throw util::unimplemented_exception( "not needed in unit test" );
+}
 
 void WHMock::importInfection(){
     throw util::unimplemented_exception( "not needed in unit test" );
@@ -95,6 +98,9 @@ double WHMock::getCumulative_h() const{
 double WHMock::getCumulative_Y() const{
     throw util::unimplemented_exception( "not needed in unit test" );
 }
+void WHMock::reset( double ){
+    throw util::unimplemented_exception( "not needed in unit test" );
+}
 
 void WHMock::checkpoint (istream& stream){
     throw util::unimplemented_exception( "not needed in unit test" );
@@ -48,6 +48,7 @@ public:
     virtual double probTransmissionToMosquito( double tbvFactor, double *sumX ) const;
     virtual double pTransGenotype( double pTrans, double sumX, size_t genotype );
     virtual bool summarize(const Host::Human& human)const;
+    virtual void memoryStats( util::MemoryStats& stats )const;
     virtual void importInfection();
     virtual void treatment( Host::Human& human, TreatmentId treatId );
     virtual void optionalPqTreatment( const Host::Human& human );
@@ -60,6 +61,7 @@ public:
     virtual void clearImmunity();
     virtual double getCumulative_h() const;
     virtual double getCumulative_Y() const;
+    virtual void reset( double comorbidityFactor );
 
     // This mock class does not have actual infections. Just set this as you please.
     double totalDensity;
@@ -22,6 +22,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
 
 import sys
 import string
+import struct
 from optparse import OptionParser
 from approxEqual import ApproxSame
 
@@ -42,9 +43,35 @@ def charEqual (fn1,fn2):
         if s1 != s2:
             return False
 
+# "OMCT": header of binary ctsout files (written with --ctsout-binary)
+BINARY_BOM=0x54434D4F
+
+def readBinarySums(f):
+    """read a binary ctsout file (after its BOM); return titles and column sums"""
+    version,nCols=struct.unpack('<II',f.read(8))
+    if version!=1:
+        raise IOError("unsupported binary ctsout version: "+str(version))
+    titles=[]
+    for i in range(nCols):
+        n=struct.unpack('<B',f.read(1))[0]
+        titles.append(f.read(n).strip())
+    cols=[0.0 for x in range(nCols)]
+    rowSize=8*nCols
+    while True:
+        row=f.read(rowSize)
+        if len(row)<rowSize:
+            break
+        for i,x in enumerate(struct.unpack('<'+str(nCols)+'d',row)):
+            cols[i] += x
+    return titles,cols
+
 def readSums(fn):
     """return list of titles and list of column sums"""
-    f=open(fn,'r')
+    f=open(fn,'rb')
+    bom=f.read(4)
+    if len(bom)==4 and struct.unpack('<I',bom)[0]==BINARY_BOM:
+        return readBinarySums(f)
+    f.seek(0)
     titles=[s.strip() for s in f.readline().split('\t')]
     if titles==['##','##']:
         # first line is auxilliary header...
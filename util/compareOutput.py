@@ -28,6 +28,8 @@ from readOutput import readEntries
 
 REL_PRECISION=1e-6
 ABS_PRECISION=1e-6
+# compareTotals: measures with smaller totals are not checked
+MIN_TOTAL=100.0
 
 def charEqual (fn1,fn2):
     MAX=10*1024
@@ -150,6 +152,46 @@ ident is 1 if files are binary-equal."""
         print "\033[1;31m"+str(numDiffs)+" significant differences (total relative diff: "+str(approxSame.getTotalRelDiff())+ ")!\033[0;0m"
         return 1,False
 
+def compareTotals(fn1,fn2,relTol,minTotal=MIN_TOTAL):
+    """Compare per-measure totals (over all surveys and groups) of two output
+files, for runs which should be statistically but not exactly equivalent.
+Passes if, for each measure with a total of at least minTotal in fn1, the
+total in fn2 is within relative difference relTol. Measures with smaller totals
+are dominated by noise and are only reported. Returns ret,ident as main()."""
+    print "\033[1;34m  compareOutput.compareTotals "+fn1+" "+fn2+" (tolerance "+str(relTol)+")\033[0;0m"
+    try:
+        values1=readEntries(fn1)
+        values2=readEntries(fn2)
+    except IOError, e:
+        print str(e)
+        return 1,False
+    totals1=dict()
+    totals2=dict()
+    for (k,v) in values1.iteritems():
+        totals1[k.a] = totals1.get(k.a,0.0) + v
+    for (k,v) in values2.iteritems():
+        totals2[k.a] = totals2.get(k.a,0.0) + v
+    
+    ret=0
+    for m in sorted(set(totals1) | set(totals2)):
+        if not (m in totals1 and m in totals2):
+            print "\033[1;31mmeasure "+str(m)+" missing from "+(fn2 if m in totals1 else fn1)+"\033[0;0m"
+            ret=3
+            continue
+        sum1=totals1[m]
+        sum2=totals2[m]
+        if not (math.fabs(sum1) >= minTotal):
+            print "for measure "+str(m)+":\tsum(1st file):"+str(sum1)+"\tsum(2nd file):"+str(sum2)+"\t(not checked)"
+            continue
+        relDiff=math.fabs(sum2-sum1)/math.fabs(sum1)
+        ok = relDiff <= relTol     # false if NaN
+        print ("" if ok else "\033[1;31m")+"for measure "+str(m)+":\tsum(1st file):"+str(sum1)+"\tsum(2nd file):"+str(sum2)+"\t(abs diff)/sum: "+str(relDiff)+("" if ok else "\033[0;0m")
+        if not ok:
+            ret=max(ret,1)
+    if ret==0:
+        print "All measure totals within tolerance, ok."
+    return ret,False
+
 # Test for options
 def evalOptions (args):
     parser = OptionParser(usage="Usage: %prog [options] logfile1 logfile2 [max different lines to print]",
@@ -20,6 +20,9 @@
 # Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
 
 import string
+import struct
+import array
+import sys
 import unittest
 
 class Keys:
@@ -80,6 +83,92 @@ class TestMultiKeys (unittest.TestCase):
         self.assert_ (self.a1.__hash__() != self.a3.__hash__()) # actually, hash collisions are possible
         self.assert_ (self.b1.__hash__() == self.b2.__hash__())
 
+# Byte-order mark at the start of binary output files ("OMBO" in little-endian)
+BINARY_BOM = 0x4F424D4F
+
+def isBinaryOutput(fileName):
+    """Return True if fileName starts with the binary output byte-order mark
+    (written by openMalaria --output-binary), in either byte order."""
+    fileObj = open(fileName, 'rb')
+    head = fileObj.read(4)
+    fileObj.close()
+    if len(head) != 4:
+        return False
+    return BINARY_BOM in (struct.unpack('<I', head)[0], struct.unpack('>I', head)[0])
+
+def readBinaryColumns(fileName):
+    """Read a binary output file; return a dict of column name to array.
+
+    Format: uint32 byte-order mark, uint32 version, uint32 number of columns,
+    uint64 number of rows, then per column: uint8 name length, name, type
+    code ('u': unsigned int, 'i': signed int, 'f': float) and uint8 width in
+    bytes; then each column's data in the same order."""
+    fileObj = open(fileName, 'rb')
+    data = fileObj.read()
+    fileObj.close()
+    
+    order = '<'
+    if struct.unpack('<I', data[0:4])[0] != BINARY_BOM:
+        order = '>'
+        if struct.unpack('>I', data[0:4])[0] != BINARY_BOM:
+            raise Exception(fileName+": not a binary output file")
+    version, nCols, nRows = struct.unpack(order+'IIQ', data[4:20])
+    if version != 1:
+        raise Exception(fileName+": unsupported binary output version "+str(version))
+    pos = 20
+    descriptors = list()
+    for i in range(nCols):
+        nameLen = ord(data[pos])
+        name = data[pos+1:pos+1+nameLen]
+        pos += 1+nameLen
+        typeCode, width = data[pos], ord(data[pos+1])
+        pos += 2
+        descriptors.append((name, typeCode, width))
+    
+    # array type codes by (type code, width)
+    arrayCodes = { ('u',4):'I', ('i',4):'i', ('f',4):'f', ('f',8):'d' }
+    swap = (order == '<') != (sys.byteorder == 'little')
+    columns = dict()
+    for name, typeCode, width in descriptors:
+        col = array.array(arrayCodes[(typeCode, width)])
+        assert col.itemsize == width
+        end = pos + nRows * width
+        col.fromstring(data[pos:end])
+        if swap:
+            col.byteswap()
+        columns[name] = col
+        pos = end
+    if pos != len(data):
+        raise Exception(fileName+": unexpected data at end of file")
+    return columns
+
+def iterRecords(fileName):
+    """Iterate over records in an output file, either text or binary, as
+    tuples (survey, col2, measure, value) where col2 packs group, cohort and
+    genotype as in output.txt and value is a string (text) or float (binary).
+    """
+    if isBinaryOutput(fileName):
+        cols = readBinaryColumns(fileName)
+        for i in xrange(len(cols['value'])):
+            col2 = (cols['ageGroup'][i] + cols['species'][i] +
+                    1000 * cols['cohortSet'][i] +
+                    1000000 * (cols['genotype'][i] + cols['drug'][i]))
+            yield cols['survey'][i], col2, cols['measure'][i], cols['value'][i]
+        return
+    fileObj = open(fileName, 'r')
+    nErrs=0
+    for line in fileObj:
+        items=string.split(line)
+        if (len(items) != 4):
+            print "expected 4 items on line; found (following line):"
+            print line
+            nErrs+=1
+            if nErrs>5:
+                raise Exception ("Too many errors reading "+fileName)
+            continue
+        yield int(items[0]), int(items[1]), int(items[2]), items[3]
+    fileObj.close()
+
 def isAgeGroup(measure):
     if measure in set([7,9,21,25,26,28,29,31,32,33,34,35,36,39,40,47,48,49,50,51,54]):
         return False
@@ -165,21 +254,7 @@ class ValDict (object):
             self.files.append(fileName)
         else:
             fID = 0
-        fileObj = open(fileName, 'r')
-        nErrs=0
-        for line in fileObj:
-            items=string.split(line)
-            if (len(items) != 4):
-                print "expected 4 items on line; found (following line):"
-                print line
-                nErrs+=1
-                if nErrs>5:
-                    raise Exception ("Too many errors reading "+fileName)
-                continue
-            
-            m=int(items[2])
-            s=int(items[0])
-            g=int(items[1])
+        for s,g,m,value in iterRecords(fileName):
             gt = g / 1000000 # genotype
             g = g - 1000000*gt
             c = g / 1000   # cohort
@@ -200,7 +275,7 @@ class ValDict (object):
                 i+=1
             self.measures.add(m)
             self.nSurveys=max(self.nSurveys,s)
-            self.values[m].add(s,g,c,gt,fID,robustFloat(items[3]))
+            self.values[m].add(s,g,c,gt,fID,robustFloat(value))
     
     def getFiles(self):
         return range(len(self.files))
@@ -266,6 +341,8 @@ class ValDict (object):
 #http://stackoverflow.com/questions/2974124/reading-floating-point-numbers-with-1-qnan-values-in-python
 def robustFloat(s):
     """Return an NaN instead of throwing."""
+    if isinstance(s, float):
+        return s
     try:
         return float(s)
     except ValueError:
@@ -275,21 +352,15 @@ def robustFloat(s):
             raise
 
 def readEntries (fname):
-    """Return a dict of entries read from file. Keys have type Multi3Keys,
-    where a corresponds to measure, b to survey and c to group.
+    """Return a dict of entries read from file (text or binary output). Keys
+    have type Multi3Keys, where a corresponds to measure, b to survey and c to
+    group.
     
     Note: ValDict is probably more efficient due to use of arrays over dicts."""
     values=dict()
-    fileObj = open(fname, 'r')
-    for line in fileObj:
-        items=string.split(line)
-        if (len(items) != 4):
-            print "expected 4 items on line; found (following line):"
-            print line
-            continue
-            
-        key=Multi3Keys(int(items[2]),int(items[0]),int(items[1]))
-        values[key]=robustFloat(items[3])
+    for s,g,m,value in iterRecords(fname):
+        key=Multi3Keys(m,s,g)
+        values[key]=robustFloat(value)
     return values
 
 if __name__ == '__main__':
@@ -24,6 +24,7 @@ import string
 import os.path
 import sys
 from optparse import OptionParser
+from readOutput import iterRecords
 
 def readSwArmIds(fileName):
     """Read scenarios.csv file of all arm ids for each sweep per scenario."""
@@ -42,7 +43,8 @@ def main(args):
             description="""Given a .csv file associating scenario file names
             with sweep arms, SCENARIOS.CSV, and a directory of results,
             RESULTS_DIR, where results have the name of the scenario file but
-            with .xml substituted for .txt, a tab-separated file of combined
+            with .xml substituted for .txt (or .bin for binary output), a
+            tab-separated file of combined
             outputs, OUTPUT_FILE, is written, where each line contains arm,
             survey, group and measure identifiers, and a value.""",version="%prog 0.1")
     
@@ -66,12 +68,18 @@ def main(args):
         for x in k:
             lineStart+=x+'\t'
         resPath=os.path.join(resultDir,f.replace('.xml','.txt'))
+        binPath=os.path.join(resultDir,f.replace('.xml','.bin'))
         if os.path.isfile(resPath):
             res=open(resPath)
             for line in res:
                 outFile.write(lineStart)
                 outFile.write(line)
             res.close()
+        elif os.path.isfile(binPath):
+            # binary output (--output-binary) with the same name
+            for s,g,m,v in iterRecords(binPath):
+                outFile.write(lineStart)
+                outFile.write('%d\t%d\t%d\t%s\n' % (s,g,m,repr(v)))
         else:
             pass # missing result
     